@@ -26,5 +26,5 @@
 
 mkdir build
 cd build
-cmake -DENABLE_LIST_EXAMPLES=ON ..
+cmake -DENABLE_LIST_EXAMPLES=ON -DENABLE_LIST_BENCHMARKS=ON ..
 make -j$(nproc)
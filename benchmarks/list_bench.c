@@ -0,0 +1,597 @@
+/**
+ * @file      list_bench.c
+ * @brief     List benchmark in C
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "list.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Maximum number of elements for the benchmarks with O(n) operations
+ */
+#define BENCH_LINEAR_MAX (10000)
+
+/**
+ * Number of passes of the traversal and release benchmarks
+ */
+#define BENCH_PASSES (20)
+
+/**
+ * Producer/consumer benchmark context
+ */
+typedef struct {
+    list_t *  list;    /**< List shared by the threads */
+    size_t    ops;     /**< Number of elements produced or consumed by the thread */
+    uint32_t *values;  /**< Elements added to the list */
+    uint64_t *samples; /**< Latency of the operations of the thread */
+} bench_thread_t;
+
+/******************************************************************************/
+/* Variables                                                                  */
+/******************************************************************************/
+
+/**
+ * Output results as JSON lines instead of CSV
+ */
+static bool bench_json = false;
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t bench_now(void);
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t bench_random(uint64_t *state);
+
+/**
+ * @brief Callback function used to sort elements of the list
+ * @param list List instance
+ * @param e1 First element
+ * @param e2 Second element
+ * @return true if e1 must be placed before e2, false otherwise
+ */
+static bool bench_sort(list_t *list, void *e1, void *e2);
+
+/**
+ * @brief Callback function used to sort latency samples
+ * @param a First sample
+ * @param b Second sample
+ * @return Comparison result
+ */
+static int bench_compare(const void *a, const void *b);
+
+/**
+ * @brief Print result of a benchmark
+ * @param name Name of the benchmark
+ * @param size Number of elements of the list
+ * @param threads Number of threads
+ * @param ops Number of operations
+ * @param duration Duration of the benchmark in nanoseconds
+ * @param samples Latency samples in nanoseconds per operation, sorted by the function
+ * @param count Number of latency samples
+ */
+static void bench_print(const char *name, size_t size, size_t threads, size_t ops, uint64_t duration, uint64_t *samples, size_t count);
+
+/**
+ * @brief Run benchmarks adding elements to the list
+ * @param size Number of elements of the list
+ */
+static void bench_add(size_t size);
+
+/**
+ * @brief Run benchmarks removing elements of the list
+ * @param size Number of elements of the list
+ */
+static void bench_remove(size_t size);
+
+/**
+ * @brief Run benchmark parsing the list
+ * @param size Number of elements of the list
+ */
+static void bench_traversal(size_t size);
+
+/**
+ * @brief Run benchmark releasing the list
+ * @param size Number of elements of the list
+ */
+static void bench_release(size_t size);
+
+/**
+ * @brief Run benchmark with producer threads adding elements to the list and consumer threads removing them
+ * @param size Number of elements exchanged
+ * @param threads Number of producer threads, which is also the number of consumer threads
+ */
+static void bench_producer_consumer(size_t size, size_t threads);
+
+/**
+ * @brief Producer thread adding elements to the tail of the list
+ * @param arg Benchmark context
+ * @return Unused
+ */
+static void *bench_producer(void *arg);
+
+/**
+ * @brief Consumer thread removing elements from the head of the list
+ * @param arg Benchmark context
+ * @return Unused
+ */
+static void *bench_consumer(void *arg);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Main function
+ * @param argc Number of arguments
+ * @param argv Arguments, "--json" to output results as JSON lines
+ * @return Always returns 0
+ */
+int
+main(int argc, char **argv) {
+
+    static const size_t sizes[]   = { 1000, 10000, 100000 };
+    static const size_t threads[] = { 1, 2, 4 };
+
+    /* Parse arguments */
+    for (int index = 1; index < argc; index++) {
+        if (0 == strcmp(argv[index], "--json")) {
+            bench_json = true;
+        }
+    }
+
+    /* Run benchmarks */
+    if (false == bench_json) {
+        printf("benchmark,size,threads,ops,ns_per_op,ops_per_s,p50_ns,p90_ns,p99_ns,p999_ns\n");
+    }
+    for (size_t index = 0; index < sizeof(sizes) / sizeof(size_t); index++) {
+        bench_add(sizes[index]);
+        bench_remove(sizes[index]);
+        bench_traversal(sizes[index]);
+        bench_release(sizes[index]);
+        for (size_t count = 0; count < sizeof(threads) / sizeof(size_t); count++) {
+            bench_producer_consumer(sizes[index], threads[count]);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t
+bench_now(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t
+bench_random(uint64_t *state) {
+
+    /* xorshift64 generator */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return (uint32_t)(*state >> 32);
+}
+
+/**
+ * @brief Callback function used to sort elements of the list
+ * @param list List instance
+ * @param e1 First element
+ * @param e2 Second element
+ * @return true if e1 must be placed before e2, false otherwise
+ */
+static bool
+bench_sort(list_t *list, void *e1, void *e2) {
+
+    (void)list;
+
+    return *(uint32_t *)e1 < *(uint32_t *)e2;
+}
+
+/**
+ * @brief Callback function used to sort latency samples
+ * @param a First sample
+ * @param b Second sample
+ * @return Comparison result
+ */
+static int
+bench_compare(const void *a, const void *b) {
+
+    uint64_t sample1 = *(const uint64_t *)a;
+    uint64_t sample2 = *(const uint64_t *)b;
+
+    return (sample1 > sample2) - (sample1 < sample2);
+}
+
+/**
+ * @brief Print result of a benchmark
+ * @param name Name of the benchmark
+ * @param size Number of elements of the list
+ * @param threads Number of threads
+ * @param ops Number of operations
+ * @param duration Duration of the benchmark in nanoseconds
+ * @param samples Latency samples in nanoseconds per operation, sorted by the function
+ * @param count Number of latency samples
+ */
+static void
+bench_print(const char *name, size_t size, size_t threads, size_t ops, uint64_t duration, uint64_t *samples, size_t count) {
+
+    /* Compute percentiles */
+    qsort(samples, count, sizeof(uint64_t), bench_compare);
+    uint64_t p50  = samples[(count * 50) / 100];
+    uint64_t p90  = samples[(count * 90) / 100];
+    uint64_t p99  = samples[(count * 99) / 100];
+    uint64_t p999 = samples[(count * 999) / 1000];
+
+    /* Print results */
+    double ns_per_op = (double)duration / (double)ops;
+    double ops_per_s = (0 < duration) ? (double)ops * 1e9 / (double)duration : 0;
+    if (true == bench_json) {
+        printf("{\"benchmark\":\"%s\",\"size\":%zu,\"threads\":%zu,\"ops\":%zu,\"ns_per_op\":%.1f,\"ops_per_s\":%.0f,"
+               "\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu}\n",
+               name,
+               size,
+               threads,
+               ops,
+               ns_per_op,
+               ops_per_s,
+               (unsigned long long)p50,
+               (unsigned long long)p90,
+               (unsigned long long)p99,
+               (unsigned long long)p999);
+    } else {
+        printf("%s,%zu,%zu,%zu,%.1f,%.0f,%llu,%llu,%llu,%llu\n",
+               name,
+               size,
+               threads,
+               ops,
+               ns_per_op,
+               ops_per_s,
+               (unsigned long long)p50,
+               (unsigned long long)p90,
+               (unsigned long long)p99,
+               (unsigned long long)p999);
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Run benchmarks adding elements to the list
+ * @param size Number of elements of the list
+ */
+static void
+bench_add(size_t size) {
+
+    static const char *names[] = { "add_head", "add_tail", "add_sorted" };
+
+    uint64_t  state   = 0x9e3779b97f4a7c15ULL;
+    uint64_t *samples = (uint64_t *)malloc(size * sizeof(uint64_t));
+    if (NULL == samples) {
+        printf("unable to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Add elements to the head, to the tail and sorted, sorted add is O(n) */
+    for (size_t mode = 0; mode < sizeof(names) / sizeof(char *); mode++) {
+        if ((2 == mode) && (BENCH_LINEAR_MAX < size)) {
+            continue;
+        }
+        list_t *list = list_create(true, (2 == mode) ? bench_sort : NULL);
+        if (NULL == list) {
+            printf("unable to create list instance\n");
+            exit(EXIT_FAILURE);
+        }
+        uint64_t start = bench_now();
+        for (size_t index = 0; index < size; index++) {
+            uint32_t value = bench_random(&state);
+            uint64_t begin = bench_now();
+            if (0 == mode) {
+                list_add_head(list, &value, sizeof(uint32_t));
+            } else if (1 == mode) {
+                list_add_tail(list, &value, sizeof(uint32_t));
+            } else {
+                list_add(list, &value, sizeof(uint32_t));
+            }
+            samples[index] = bench_now() - begin;
+        }
+        uint64_t duration = bench_now() - start;
+        bench_print(names[mode], size, 1, size, duration, samples, size);
+        list_release(list);
+    }
+
+    /* Release memory */
+    free(samples);
+}
+
+/**
+ * @brief Run benchmarks removing elements of the list
+ * @param size Number of elements of the list
+ */
+static void
+bench_remove(size_t size) {
+
+    static const char *names[] = { "remove_head", "remove_tail", "remove_ptr" };
+
+    uint64_t   state   = 0x9e3779b97f4a7c15ULL;
+    uint64_t * samples = (uint64_t *)malloc(size * sizeof(uint64_t));
+    uint32_t * values  = (uint32_t *)malloc(size * sizeof(uint32_t));
+    uint32_t **order   = (uint32_t **)malloc(size * sizeof(uint32_t *));
+    if ((NULL == samples) || (NULL == values) || (NULL == order)) {
+        printf("unable to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Remove elements from the head, from the tail and by pointer in random order, remove by pointer is O(n) */
+    for (size_t mode = 0; mode < sizeof(names) / sizeof(char *); mode++) {
+        if ((2 == mode) && (BENCH_LINEAR_MAX < size)) {
+            continue;
+        }
+        list_t *list = list_create(false, NULL);
+        if (NULL == list) {
+            printf("unable to create list instance\n");
+            exit(EXIT_FAILURE);
+        }
+        for (size_t index = 0; index < size; index++) {
+            values[index] = (uint32_t)index;
+            order[index]  = &values[index];
+            list_add_tail(list, &values[index], sizeof(uint32_t));
+        }
+        for (size_t index = size - 1; 0 < index; index--) {
+            size_t    other = bench_random(&state) % (index + 1);
+            uint32_t *tmp   = order[index];
+            order[index]    = order[other];
+            order[other]    = tmp;
+        }
+        uint64_t start = bench_now();
+        for (size_t index = 0; index < size; index++) {
+            uint64_t begin = bench_now();
+            if (0 == mode) {
+                list_remove_head(list);
+            } else if (1 == mode) {
+                list_remove_tail(list);
+            } else {
+                list_remove(list, order[index]);
+            }
+            samples[index] = bench_now() - begin;
+        }
+        uint64_t duration = bench_now() - start;
+        bench_print(names[mode], size, 1, size, duration, samples, size);
+        list_release(list);
+    }
+
+    /* Release memory */
+    free(order);
+    free(values);
+    free(samples);
+}
+
+/**
+ * @brief Run benchmark parsing the list
+ * @param size Number of elements of the list
+ */
+static void
+bench_traversal(size_t size) {
+
+    uint64_t samples[BENCH_PASSES];
+    uint64_t duration = 0;
+    size_t   count    = 0;
+
+    /* Create list */
+    list_t *list = list_create(true, NULL);
+    if (NULL == list) {
+        printf("unable to create list instance\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t index = 0; index < size; index++) {
+        uint32_t value = (uint32_t)index;
+        list_add_tail(list, &value, sizeof(uint32_t));
+    }
+
+    /* Parse the list, latency is measured per element of each pass */
+    for (size_t pass = 0; pass < BENCH_PASSES; pass++) {
+        uint64_t start = bench_now();
+        for (uint32_t *value = list_get_head(list); NULL != value; value = list_get_next(list)) {
+            count += *value & 1;
+        }
+        uint64_t elapsed = bench_now() - start;
+        samples[pass]    = elapsed / size;
+        duration += elapsed;
+    }
+    if (0 == count) {
+        printf("unexpected traversal result\n");
+    }
+    bench_print("traversal", size, 1, size * BENCH_PASSES, duration, samples, BENCH_PASSES);
+
+    /* Release memory */
+    list_release(list);
+}
+
+/**
+ * @brief Run benchmark releasing the list
+ * @param size Number of elements of the list
+ */
+static void
+bench_release(size_t size) {
+
+    uint64_t samples[BENCH_PASSES];
+    uint64_t duration = 0;
+
+    /* Release lists, latency is measured per element of each list */
+    for (size_t pass = 0; pass < BENCH_PASSES; pass++) {
+        list_t *list = list_create(true, NULL);
+        if (NULL == list) {
+            printf("unable to create list instance\n");
+            exit(EXIT_FAILURE);
+        }
+        for (size_t index = 0; index < size; index++) {
+            uint32_t value = (uint32_t)index;
+            list_add_tail(list, &value, sizeof(uint32_t));
+        }
+        uint64_t start = bench_now();
+        list_release(list);
+        uint64_t elapsed = bench_now() - start;
+        samples[pass]    = elapsed / size;
+        duration += elapsed;
+    }
+    bench_print("release", size, 1, size * BENCH_PASSES, duration, samples, BENCH_PASSES);
+}
+
+/**
+ * @brief Run benchmark with producer threads adding elements to the list and consumer threads removing them
+ * @param size Number of elements exchanged
+ * @param threads Number of producer threads, which is also the number of consumer threads
+ */
+static void
+bench_producer_consumer(size_t size, size_t threads) {
+
+    pthread_t      producers[threads];
+    pthread_t      consumers[threads];
+    bench_thread_t contexts[2 * threads];
+
+    /* Create list */
+    list_t *list = list_create(false, NULL);
+    if (NULL == list) {
+        printf("unable to create list instance\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Prepare threads, latency of the operations of all the threads is measured */
+    uint32_t *values  = (uint32_t *)malloc(size * sizeof(uint32_t));
+    uint64_t *samples = (uint64_t *)malloc(2 * size * sizeof(uint64_t));
+    if ((NULL == values) || (NULL == samples)) {
+        printf("unable to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t ops = size / threads;
+    for (size_t index = 0; index < threads; index++) {
+        contexts[index].list              = list;
+        contexts[index].ops               = ops;
+        contexts[index].values            = &values[index * ops];
+        contexts[index].samples           = &samples[index * ops];
+        contexts[threads + index].list    = list;
+        contexts[threads + index].ops     = ops;
+        contexts[threads + index].values  = NULL;
+        contexts[threads + index].samples = &samples[(threads + index) * ops];
+    }
+
+    /* Run threads */
+    uint64_t start = bench_now();
+    for (size_t index = 0; index < threads; index++) {
+        pthread_create(&producers[index], NULL, bench_producer, &contexts[index]);
+        pthread_create(&consumers[index], NULL, bench_consumer, &contexts[threads + index]);
+    }
+    for (size_t index = 0; index < threads; index++) {
+        pthread_join(producers[index], NULL);
+        pthread_join(consumers[index], NULL);
+    }
+    uint64_t duration = bench_now() - start;
+    bench_print("producer_consumer", size, 2 * threads, 2 * ops * threads, duration, samples, 2 * ops * threads);
+
+    /* Release memory */
+    list_release(list);
+    free(samples);
+    free(values);
+}
+
+/**
+ * @brief Producer thread adding elements to the tail of the list
+ * @param arg Benchmark context
+ * @return Unused
+ */
+static void *
+bench_producer(void *arg) {
+
+    bench_thread_t *context = (bench_thread_t *)arg;
+
+    /* Add elements to the tail of the list */
+    for (size_t index = 0; index < context->ops; index++) {
+        context->values[index] = (uint32_t)index;
+        uint64_t begin         = bench_now();
+        list_add_tail(context->list, &context->values[index], sizeof(uint32_t));
+        context->samples[index] = bench_now() - begin;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Consumer thread removing elements from the head of the list
+ * @param arg Benchmark context
+ * @return Unused
+ */
+static void *
+bench_consumer(void *arg) {
+
+    bench_thread_t *context = (bench_thread_t *)arg;
+
+    /* Remove elements from the head of the list, the consumer waits for elements if the list is empty */
+    size_t index = 0;
+    while (index < context->ops) {
+        uint64_t begin = bench_now();
+        if (NULL != list_remove_head(context->list)) {
+            context->samples[index] = bench_now() - begin;
+            index++;
+        }
+    }
+
+    return NULL;
+}
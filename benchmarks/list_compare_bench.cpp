@@ -0,0 +1,688 @@
+/**
+ * @file      list_compare_bench.cpp
+ * @brief     Comparison of the list with other containers
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#ifdef HAVE_SYS_QUEUE_H
+#include <sys/queue.h>
+#endif
+#ifdef HAVE_GLIB
+#include <glib.h>
+#endif
+
+#include "list.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Number of elements of the FIFO and traversal workloads
+ */
+#define BENCH_SIZE (100000)
+
+/**
+ * Number of elements of the sorted insertion and random removal workloads
+ */
+#define BENCH_SIZE_LINEAR (10000)
+
+/**
+ * Number of passes of the traversal workload
+ */
+#define BENCH_PASSES (20)
+
+/**
+ * Container operations, identical workloads are run on each container
+ */
+typedef struct {
+    const char *name;                               /**< Name of the container */
+    void *(*create)(bool sorted);                   /**< Create the container, sorted if insert_sorted is used */
+    void (*destroy)(void *c);                       /**< Release the container and its elements */
+    void (*push)(void *c, uint32_t value);          /**< Add element to the tail */
+    bool (*pop)(void *c, uint32_t *value);          /**< Remove element from the head */
+    void (*insert_sorted)(void *c, uint32_t value); /**< Add element in ascending order */
+    void *(*add_handle)(void *c, uint32_t value);   /**< Add element to the tail and return a handle */
+    void (*remove_handle)(void *c, void *handle);   /**< Remove element using its handle */
+    uint64_t (*sum)(void *c);                       /**< Parse the container */
+} bench_container_t;
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t bench_now(void);
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t bench_random(uint64_t *state);
+
+/**
+ * @brief Get number of bytes allocated on the heap
+ * @return Number of bytes allocated, 0 if not available
+ */
+static size_t bench_heap(void);
+
+/**
+ * @brief Run workloads on a container and print the results
+ * @param container Container operations
+ */
+static void bench_run(const bench_container_t *container);
+
+/******************************************************************************/
+/* Containers                                                                 */
+/******************************************************************************/
+
+/* c-list, elements are copied in the list, handles are list elements */
+
+static bool
+clist_sort(list_t *list, void *e1, void *e2) {
+    (void)list;
+    return *(uint32_t *)e1 < *(uint32_t *)e2;
+}
+
+static void *
+clist_create(bool sorted) {
+    return list_create(true, (true == sorted) ? clist_sort : NULL);
+}
+
+static void
+clist_destroy(void *c) {
+    list_release((list_t *)c);
+}
+
+static void
+clist_push(void *c, uint32_t value) {
+    list_add_tail((list_t *)c, &value, sizeof(uint32_t));
+}
+
+static bool
+clist_pop(void *c, uint32_t *value) {
+    uint32_t *e = (uint32_t *)list_remove_head((list_t *)c);
+    if (NULL == e) {
+        return false;
+    }
+    *value = *e;
+    list_free_element((list_t *)c, e, sizeof(uint32_t));
+    return true;
+}
+
+static void
+clist_insert_sorted(void *c, uint32_t value) {
+    list_add((list_t *)c, &value, sizeof(uint32_t));
+}
+
+static void *
+clist_add_handle(void *c, uint32_t value) {
+    return list_add_handle((list_t *)c, &value, sizeof(uint32_t));
+}
+
+static void
+clist_remove_handle(void *c, void *handle) {
+    list_remove_handle((list_t *)c, (list_element_t *)handle);
+}
+
+static uint64_t
+clist_sum(void *c) {
+    uint64_t sum = 0;
+    for (uint32_t *e = (uint32_t *)list_get_head((list_t *)c); NULL != e; e = (uint32_t *)list_get_next((list_t *)c)) {
+        sum += *e;
+    }
+    return sum;
+}
+
+#ifdef HAVE_SYS_QUEUE_H
+
+/* BSD sys/queue.h tail queue, intrusive nodes allocated with malloc, handles are nodes */
+
+typedef struct tailq_node_s {
+    TAILQ_ENTRY(tailq_node_s) entries;
+    uint32_t value;
+} tailq_node_t;
+
+TAILQ_HEAD(tailq_head_s, tailq_node_s);
+
+static void *
+tailq_create(bool sorted) {
+    (void)sorted;
+    struct tailq_head_s *head = (struct tailq_head_s *)malloc(sizeof(struct tailq_head_s));
+    TAILQ_INIT(head);
+    return head;
+}
+
+static void
+tailq_destroy(void *c) {
+    struct tailq_head_s *head = (struct tailq_head_s *)c;
+    while (!TAILQ_EMPTY(head)) {
+        tailq_node_t *node = TAILQ_FIRST(head);
+        TAILQ_REMOVE(head, node, entries);
+        free(node);
+    }
+    free(head);
+}
+
+static void *
+tailq_add_handle(void *c, uint32_t value) {
+    tailq_node_t *node = (tailq_node_t *)malloc(sizeof(tailq_node_t));
+    node->value        = value;
+    TAILQ_INSERT_TAIL((struct tailq_head_s *)c, node, entries);
+    return node;
+}
+
+static void
+tailq_push(void *c, uint32_t value) {
+    tailq_add_handle(c, value);
+}
+
+static bool
+tailq_pop(void *c, uint32_t *value) {
+    struct tailq_head_s *head = (struct tailq_head_s *)c;
+    tailq_node_t *       node = TAILQ_FIRST(head);
+    if (NULL == node) {
+        return false;
+    }
+    TAILQ_REMOVE(head, node, entries);
+    *value = node->value;
+    free(node);
+    return true;
+}
+
+static void
+tailq_insert_sorted(void *c, uint32_t value) {
+    struct tailq_head_s *head = (struct tailq_head_s *)c;
+    tailq_node_t *       node = (tailq_node_t *)malloc(sizeof(tailq_node_t));
+    node->value               = value;
+    tailq_node_t *tmp;
+    TAILQ_FOREACH(tmp, head, entries) {
+        if (value < tmp->value) {
+            TAILQ_INSERT_BEFORE(tmp, node, entries);
+            return;
+        }
+    }
+    TAILQ_INSERT_TAIL(head, node, entries);
+}
+
+static void
+tailq_remove_handle(void *c, void *handle) {
+    TAILQ_REMOVE((struct tailq_head_s *)c, (tailq_node_t *)handle, entries);
+    free(handle);
+}
+
+static uint64_t
+tailq_sum(void *c) {
+    uint64_t      sum = 0;
+    tailq_node_t *node;
+    TAILQ_FOREACH(node, (struct tailq_head_s *)c, entries) {
+        sum += node->value;
+    }
+    return sum;
+}
+
+#endif
+
+#ifdef HAVE_GLIB
+
+/* glib GQueue, values are stored in the data pointer of the links, handles are links */
+
+static gint
+gqueue_compare(gconstpointer a, gconstpointer b, gpointer data) {
+    (void)data;
+    return (GPOINTER_TO_UINT(a) > GPOINTER_TO_UINT(b)) - (GPOINTER_TO_UINT(a) < GPOINTER_TO_UINT(b));
+}
+
+static void *
+gqueue_create(bool sorted) {
+    (void)sorted;
+    return g_queue_new();
+}
+
+static void
+gqueue_destroy(void *c) {
+    g_queue_free((GQueue *)c);
+}
+
+static void
+gqueue_push(void *c, uint32_t value) {
+    g_queue_push_tail((GQueue *)c, GUINT_TO_POINTER(value));
+}
+
+static bool
+gqueue_pop(void *c, uint32_t *value) {
+    if (true == g_queue_is_empty((GQueue *)c)) {
+        return false;
+    }
+    *value = GPOINTER_TO_UINT(g_queue_pop_head((GQueue *)c));
+    return true;
+}
+
+static void
+gqueue_insert_sorted(void *c, uint32_t value) {
+    g_queue_insert_sorted((GQueue *)c, GUINT_TO_POINTER(value), gqueue_compare, NULL);
+}
+
+static void *
+gqueue_add_handle(void *c, uint32_t value) {
+    g_queue_push_tail((GQueue *)c, GUINT_TO_POINTER(value));
+    return g_queue_peek_tail_link((GQueue *)c);
+}
+
+static void
+gqueue_remove_handle(void *c, void *handle) {
+    g_queue_delete_link((GQueue *)c, (GList *)handle);
+}
+
+static uint64_t
+gqueue_sum(void *c) {
+    uint64_t sum = 0;
+    for (GList *link = g_queue_peek_head_link((GQueue *)c); NULL != link; link = link->next) {
+        sum += GPOINTER_TO_UINT(link->data);
+    }
+    return sum;
+}
+
+/* glib GList, a tail pointer is kept to append links in constant time, handles are links */
+
+typedef struct {
+    GList *head; /**< First link */
+    GList *tail; /**< Last link, NULL if unknown */
+} glist_t;
+
+static void *
+glist_create(bool sorted) {
+    (void)sorted;
+    return calloc(1, sizeof(glist_t));
+}
+
+static void
+glist_destroy(void *c) {
+    g_list_free(((glist_t *)c)->head);
+    free(c);
+}
+
+static void *
+glist_add_handle(void *c, uint32_t value) {
+    glist_t *l    = (glist_t *)c;
+    GList *  link = g_list_alloc();
+    link->data    = GUINT_TO_POINTER(value);
+    if ((NULL == l->tail) && (NULL != l->head)) {
+        l->tail = g_list_last(l->head);
+    }
+    link->prev = l->tail;
+    if (NULL != l->tail) {
+        l->tail->next = link;
+    } else {
+        l->head = link;
+    }
+    l->tail = link;
+    return link;
+}
+
+static void
+glist_push(void *c, uint32_t value) {
+    glist_add_handle(c, value);
+}
+
+static bool
+glist_pop(void *c, uint32_t *value) {
+    glist_t *l = (glist_t *)c;
+    if (NULL == l->head) {
+        return false;
+    }
+    *value = GPOINTER_TO_UINT(l->head->data);
+    if (l->tail == l->head) {
+        l->tail = NULL;
+    }
+    l->head = g_list_delete_link(l->head, l->head);
+    return true;
+}
+
+static void
+glist_insert_sorted(void *c, uint32_t value) {
+    glist_t *l = (glist_t *)c;
+    l->head    = g_list_insert_sorted_with_data(l->head, GUINT_TO_POINTER(value), gqueue_compare, NULL);
+    l->tail    = NULL;
+}
+
+static void
+glist_remove_handle(void *c, void *handle) {
+    glist_t *l = (glist_t *)c;
+    if (l->tail == (GList *)handle) {
+        l->tail = l->tail->prev;
+    }
+    l->head = g_list_delete_link(l->head, (GList *)handle);
+}
+
+static uint64_t
+glist_sum(void *c) {
+    uint64_t sum = 0;
+    for (GList *link = ((glist_t *)c)->head; NULL != link; link = link->next) {
+        sum += GPOINTER_TO_UINT(link->data);
+    }
+    return sum;
+}
+
+#endif
+
+/* C++ std::list, handles are iterators allocated with new */
+
+static void *
+stdlist_create(bool sorted) {
+    (void)sorted;
+    return new std::list<uint32_t>();
+}
+
+static void
+stdlist_destroy(void *c) {
+    delete (std::list<uint32_t> *)c;
+}
+
+static void
+stdlist_push(void *c, uint32_t value) {
+    ((std::list<uint32_t> *)c)->push_back(value);
+}
+
+static bool
+stdlist_pop(void *c, uint32_t *value) {
+    std::list<uint32_t> *l = (std::list<uint32_t> *)c;
+    if (true == l->empty()) {
+        return false;
+    }
+    *value = l->front();
+    l->pop_front();
+    return true;
+}
+
+static void
+stdlist_insert_sorted(void *c, uint32_t value) {
+    std::list<uint32_t> *l = (std::list<uint32_t> *)c;
+    l->insert(std::upper_bound(l->begin(), l->end(), value), value);
+}
+
+static void *
+stdlist_add_handle(void *c, uint32_t value) {
+    std::list<uint32_t> *l = (std::list<uint32_t> *)c;
+    return new std::list<uint32_t>::iterator(l->insert(l->end(), value));
+}
+
+static void
+stdlist_remove_handle(void *c, void *handle) {
+    std::list<uint32_t>::iterator *it = (std::list<uint32_t>::iterator *)handle;
+    ((std::list<uint32_t> *)c)->erase(*it);
+    delete it;
+}
+
+static uint64_t
+stdlist_sum(void *c) {
+    uint64_t sum = 0;
+    for (uint32_t value : *(std::list<uint32_t> *)c) {
+        sum += value;
+    }
+    return sum;
+}
+
+/* C++ std::deque, handles are values, removal searches the value and erases it */
+
+static void *
+stddeque_create(bool sorted) {
+    (void)sorted;
+    return new std::deque<uint32_t>();
+}
+
+static void
+stddeque_destroy(void *c) {
+    delete (std::deque<uint32_t> *)c;
+}
+
+static void
+stddeque_push(void *c, uint32_t value) {
+    ((std::deque<uint32_t> *)c)->push_back(value);
+}
+
+static bool
+stddeque_pop(void *c, uint32_t *value) {
+    std::deque<uint32_t> *d = (std::deque<uint32_t> *)c;
+    if (true == d->empty()) {
+        return false;
+    }
+    *value = d->front();
+    d->pop_front();
+    return true;
+}
+
+static void
+stddeque_insert_sorted(void *c, uint32_t value) {
+    std::deque<uint32_t> *d = (std::deque<uint32_t> *)c;
+    d->insert(std::upper_bound(d->begin(), d->end(), value), value);
+}
+
+static void *
+stddeque_add_handle(void *c, uint32_t value) {
+    ((std::deque<uint32_t> *)c)->push_back(value);
+    return (void *)(uintptr_t)value;
+}
+
+static void
+stddeque_remove_handle(void *c, void *handle) {
+    std::deque<uint32_t> *d = (std::deque<uint32_t> *)c;
+    d->erase(std::find(d->begin(), d->end(), (uint32_t)(uintptr_t)handle));
+}
+
+static uint64_t
+stddeque_sum(void *c) {
+    uint64_t sum = 0;
+    for (uint32_t value : *(std::deque<uint32_t> *)c) {
+        sum += value;
+    }
+    return sum;
+}
+
+/******************************************************************************/
+/* Variables                                                                  */
+/******************************************************************************/
+
+/**
+ * Containers compared
+ */
+static const bench_container_t bench_containers[] = {
+    { "c-list", clist_create, clist_destroy, clist_push, clist_pop, clist_insert_sorted, clist_add_handle, clist_remove_handle, clist_sum },
+#ifdef HAVE_SYS_QUEUE_H
+    { "TAILQ", tailq_create, tailq_destroy, tailq_push, tailq_pop, tailq_insert_sorted, tailq_add_handle, tailq_remove_handle, tailq_sum },
+#endif
+#ifdef HAVE_GLIB
+    { "GQueue", gqueue_create, gqueue_destroy, gqueue_push, gqueue_pop, gqueue_insert_sorted, gqueue_add_handle, gqueue_remove_handle, gqueue_sum },
+    { "GList", glist_create, glist_destroy, glist_push, glist_pop, glist_insert_sorted, glist_add_handle, glist_remove_handle, glist_sum },
+#endif
+    { "std::list",
+      stdlist_create,
+      stdlist_destroy,
+      stdlist_push,
+      stdlist_pop,
+      stdlist_insert_sorted,
+      stdlist_add_handle,
+      stdlist_remove_handle,
+      stdlist_sum },
+    { "std::deque",
+      stddeque_create,
+      stddeque_destroy,
+      stddeque_push,
+      stddeque_pop,
+      stddeque_insert_sorted,
+      stddeque_add_handle,
+      stddeque_remove_handle,
+      stddeque_sum },
+};
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Main function
+ * @return Always returns 0
+ */
+int
+main(void) {
+
+    /* Run workloads, throughput is given in millions of operations per second */
+    printf("%-12s %12s %12s %12s %12s %12s\n", "container", "fifo", "sorted", "removal", "traversal", "bytes/elem");
+    for (size_t index = 0; index < sizeof(bench_containers) / sizeof(bench_container_t); index++) {
+        bench_run(&bench_containers[index]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t
+bench_now(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t
+bench_random(uint64_t *state) {
+
+    /* xorshift64 generator */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return (uint32_t)(*state >> 32);
+}
+
+/**
+ * @brief Get number of bytes allocated on the heap
+ * @return Number of bytes allocated, 0 if not available
+ */
+static size_t
+bench_heap(void) {
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((2 == __GLIBC__) && (33 <= __GLIBC_MINOR__)))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Run workloads on a container and print the results
+ * @param container Container operations
+ */
+static void
+bench_run(const bench_container_t *container) {
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    uint64_t sum   = 0;
+    uint32_t value;
+
+    /* FIFO: add all elements to the tail then remove them from the head, memory is measured when the container is full */
+    size_t heap = bench_heap();
+    void * c    = container->create(false);
+    uint64_t start = bench_now();
+    for (uint32_t index = 0; index < BENCH_SIZE; index++) {
+        container->push(c, index);
+    }
+    size_t bytes = bench_heap() - heap;
+    while (true == container->pop(c, &value)) {
+        sum += value;
+    }
+    double fifo = (2.0 * BENCH_SIZE * 1e3) / (double)(bench_now() - start);
+    container->destroy(c);
+
+    /* Sorted insertion of random values */
+    c     = container->create(true);
+    start = bench_now();
+    for (uint32_t index = 0; index < BENCH_SIZE_LINEAR; index++) {
+        container->insert_sorted(c, bench_random(&state));
+    }
+    double sorted = (BENCH_SIZE_LINEAR * 1e3) / (double)(bench_now() - start);
+    container->destroy(c);
+
+    /* Random removal: removal of all the elements in random order using the handles returned when they are added */
+    std::vector<void *> handles(BENCH_SIZE_LINEAR);
+    c = container->create(false);
+    for (uint32_t index = 0; index < BENCH_SIZE_LINEAR; index++) {
+        handles[index] = container->add_handle(c, index);
+    }
+    for (size_t index = BENCH_SIZE_LINEAR - 1; 0 < index; index--) {
+        std::swap(handles[index], handles[bench_random(&state) % (index + 1)]);
+    }
+    start = bench_now();
+    for (size_t index = 0; index < BENCH_SIZE_LINEAR; index++) {
+        container->remove_handle(c, handles[index]);
+    }
+    double removal = (BENCH_SIZE_LINEAR * 1e3) / (double)(bench_now() - start);
+    container->destroy(c);
+
+    /* Traversal of the full container */
+    c = container->create(false);
+    for (uint32_t index = 0; index < BENCH_SIZE; index++) {
+        container->push(c, index);
+    }
+    start = bench_now();
+    for (size_t pass = 0; pass < BENCH_PASSES; pass++) {
+        sum += container->sum(c);
+    }
+    double traversal = ((double)BENCH_SIZE * BENCH_PASSES * 1e3) / (double)(bench_now() - start);
+    container->destroy(c);
+
+    /* Print results, sum is printed to the standard error so the traversal is not optimized out */
+    printf("%-12s %12.2f %12.2f %12.2f %12.2f %12.1f\n", container->name, fifo, sorted, removal, traversal, (double)bytes / BENCH_SIZE);
+    fflush(stdout);
+    fprintf(stderr, "%s: %llu\n", container->name, (unsigned long long)sum);
+}
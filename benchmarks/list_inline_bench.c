@@ -0,0 +1,204 @@
+/**
+ * @file      list_inline_bench.c
+ * @brief     Benchmark of the inline accessors of the list
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "list.h"
+#include "list_inline.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Number of elements parsed per measure
+ */
+#define BENCH_ELEMENTS (10000000)
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t bench_now(void);
+
+/**
+ * @brief Create list and add elements to the list
+ * @param lock Locking of the list
+ * @param size Number of elements of the list
+ * @return List instance
+ */
+static list_t *bench_create(list_lock_t lock, size_t size);
+
+/**
+ * @brief Parse the list using library functions and print the result
+ * @param name Name of the benchmark
+ * @param list List instance
+ */
+static void bench_library(const char *name, list_t *list);
+
+/**
+ * @brief Parse the list using inline accessors and print the result
+ * @param name Name of the benchmark
+ * @param list List instance
+ */
+static void bench_inline(const char *name, list_t *list);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Main function
+ * @return Always returns 0
+ */
+int
+main(void) {
+
+    static const size_t sizes[] = { 100, 10000, 1000000 };
+
+    /* Parse lists with library functions and with inline accessors, the list is parsed several times to parse the same number of elements */
+    printf("%-10s %-10s %-10s %-10s\n", "accessors", "lock", "size", "ns/elem");
+    for (size_t index = 0; index < sizeof(sizes) / sizeof(size_t); index++) {
+        list_t *list = bench_create(LIST_LOCK_SEMAPHORE, sizes[index]);
+        bench_library("semaphore", list);
+        list_release(list);
+        list = bench_create(LIST_LOCK_NONE, sizes[index]);
+        bench_library("none", list);
+        bench_inline("none", list);
+        list_release(list);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t
+bench_now(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Create list and add elements to the list
+ * @param lock Locking of the list
+ * @param size Number of elements of the list
+ * @return List instance
+ */
+static list_t *
+bench_create(list_lock_t lock, size_t size) {
+
+    list_options_t options = { 0 };
+    options.lock           = lock;
+
+    /* Create list */
+    list_t *list = list_create_ext(true, NULL, &options);
+    if (NULL == list) {
+        printf("unable to create list instance\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Add elements */
+    for (size_t index = 0; index < size; index++) {
+        uint32_t value = (uint32_t)index;
+        list_add_tail(list, &value, sizeof(uint32_t));
+    }
+
+    return list;
+}
+
+/**
+ * @brief Parse the list using library functions and print the result
+ * @param name Name of the benchmark
+ * @param list List instance
+ */
+static void
+bench_library(const char *name, list_t *list) {
+
+    size_t   count  = list_get_count(list);
+    size_t   passes = BENCH_ELEMENTS / count;
+    uint64_t sum    = 0;
+
+    /* Parse the list */
+    uint64_t start = bench_now();
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (uint32_t *value = list_get_head(list); NULL != value; value = list_get_next(list)) {
+            sum += *value;
+        }
+    }
+    uint64_t duration = bench_now() - start;
+
+    /* Print result, sum is checked so that the traversal is not optimized out */
+    if (sum != (uint64_t)passes * count * (count - 1) / 2) {
+        printf("unexpected traversal result\n");
+    }
+    printf("%-10s %-10s %-10zu %-10.2f\n", "library", name, count, (double)duration / (passes * count));
+}
+
+/**
+ * @brief Parse the list using inline accessors and print the result
+ * @param name Name of the benchmark
+ * @param list List instance
+ */
+static void
+bench_inline(const char *name, list_t *list) {
+
+    size_t   count  = list_inline_get_count(list);
+    size_t   passes = BENCH_ELEMENTS / count;
+    uint64_t sum    = 0;
+
+    /* Parse the list */
+    uint64_t start = bench_now();
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (uint32_t *value = list_inline_get_head(list); NULL != value; value = list_inline_get_next(list)) {
+            sum += *value;
+        }
+    }
+    uint64_t duration = bench_now() - start;
+
+    /* Print result, sum is checked so that the traversal is not optimized out */
+    if (sum != (uint64_t)passes * count * (count - 1) / 2) {
+        printf("unexpected traversal result\n");
+    }
+    printf("%-10s %-10s %-10zu %-10.2f\n", "inline", name, count, (double)duration / (passes * count));
+}
@@ -0,0 +1,233 @@
+/**
+ * @file      list_lru_bench.c
+ * @brief     LRU cache benchmark in C
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "list.h"
+#include "list_lru.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Capacity of the caches
+ */
+#define BENCH_CAPACITY (4096)
+
+/**
+ * Number of operations performed on the LRU cache
+ */
+#define BENCH_LRU_OPS (2000000)
+
+/**
+ * Number of operations performed on the list based cache
+ */
+#define BENCH_LIST_OPS (50000)
+
+/**
+ * Cache entry used by the list based cache
+ */
+typedef struct {
+    uint32_t key;   /**< Key of the entry */
+    uint32_t value; /**< Value of the entry */
+} bench_entry_t;
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t bench_now(void);
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t bench_random(uint64_t *state);
+
+/**
+ * @brief Run benchmark of the LRU cache
+ * @param hit_ratio Expected hit ratio
+ */
+static void bench_lru(double hit_ratio);
+
+/**
+ * @brief Run benchmark of the list based cache using list_remove and list_add_head on every hit
+ * @param hit_ratio Expected hit ratio
+ */
+static void bench_list(double hit_ratio);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Main function
+ * @return Always returns 0
+ */
+int
+main(void) {
+
+    static const double hit_ratios[] = { 0.5, 0.8, 0.9, 0.99 };
+
+    /* Run benchmarks */
+    printf("%-10s %-10s %-10s %-10s %-10s\n", "container", "target", "measured", "ops", "ns/op");
+    for (size_t index = 0; index < sizeof(hit_ratios) / sizeof(double); index++) {
+        bench_lru(hit_ratios[index]);
+        bench_list(hit_ratios[index]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t
+bench_now(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t
+bench_random(uint64_t *state) {
+
+    /* xorshift64 generator */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return (uint32_t)(*state >> 32);
+}
+
+/**
+ * @brief Run benchmark of the LRU cache
+ * @param hit_ratio Expected hit ratio
+ */
+static void
+bench_lru(double hit_ratio) {
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    uint32_t keys  = (uint32_t)(BENCH_CAPACITY / hit_ratio);
+    size_t   hits  = 0;
+
+    /* Create LRU cache */
+    list_lru_t *lru = list_lru_create(BENCH_CAPACITY, 0);
+    if (NULL == lru) {
+        printf("unable to create LRU cache instance\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Get the value of random keys and add the missing ones */
+    uint64_t start = bench_now();
+    for (size_t index = 0; index < BENCH_LRU_OPS; index++) {
+        uint32_t key   = bench_random(&state) % keys;
+        uint32_t value = 0;
+        size_t   size  = sizeof(value);
+        if (0 == list_lru_get(lru, &key, sizeof(key), &value, &size)) {
+            hits++;
+        } else {
+            list_lru_put(lru, &key, sizeof(key), &key, sizeof(key));
+        }
+    }
+    uint64_t duration = bench_now() - start;
+
+    /* Print results */
+    printf("%-10s %-10.2f %-10.2f %-10d %-10.1f\n", "list_lru", hit_ratio, (double)hits / BENCH_LRU_OPS, BENCH_LRU_OPS, (double)duration / BENCH_LRU_OPS);
+
+    /* Release memory */
+    list_lru_release(lru);
+}
+
+/**
+ * @brief Run benchmark of the list based cache using list_remove and list_add_head on every hit
+ * @param hit_ratio Expected hit ratio
+ */
+static void
+bench_list(double hit_ratio) {
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    uint32_t keys  = (uint32_t)(BENCH_CAPACITY / hit_ratio);
+    size_t   hits  = 0;
+
+    /* Create list */
+    list_t *list = list_create(true, NULL);
+    if (NULL == list) {
+        printf("unable to create list instance\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Get the value of random keys and add the missing ones */
+    uint64_t start = bench_now();
+    for (size_t index = 0; index < BENCH_LIST_OPS; index++) {
+        bench_entry_t  entry = { .key = bench_random(&state) % keys };
+        bench_entry_t *tmp   = list_get_head(list);
+        while ((NULL != tmp) && (tmp->key != entry.key)) {
+            tmp = list_get_next(list);
+        }
+        if (NULL != tmp) {
+            hits++;
+            entry.value = tmp->value;
+            list_remove(list, tmp);
+        } else {
+            entry.value = entry.key;
+            if (BENCH_CAPACITY <= list_get_count(list)) {
+                free(list_remove_tail(list));
+            }
+        }
+        list_add_head(list, &entry, sizeof(bench_entry_t));
+    }
+    uint64_t duration = bench_now() - start;
+
+    /* Print results */
+    printf("%-10s %-10.2f %-10.2f %-10d %-10.1f\n", "list", hit_ratio, (double)hits / BENCH_LIST_OPS, BENCH_LIST_OPS, (double)duration / BENCH_LIST_OPS);
+
+    /* Release memory */
+    list_release(list);
+}
@@ -0,0 +1,231 @@
+/**
+ * @file      list_typed_bench.c
+ * @brief     Benchmark of the typed lists
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "list.h"
+#include "list_typed.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Element of the lists
+ */
+typedef struct {
+    uint32_t key;   /**< Key used to sort the elements */
+    uint32_t value; /**< Value */
+} bench_item_t;
+
+/**
+ * Comparator of the elements
+ */
+#define BENCH_ITEM_BEFORE(e1, e2) ((e1)->key < (e2)->key)
+
+/**
+ * Typed list of elements
+ */
+LIST_DECLARE(bench_items, bench_item_t, BENCH_ITEM_BEFORE)
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t bench_now(void);
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t bench_random(uint64_t *state);
+
+/**
+ * @brief Callback function used to sort elements of the list
+ * @param list List instance
+ * @param e1 First element
+ * @param e2 Second element
+ * @return true if e1 must be placed before e2, false otherwise
+ */
+static bool bench_sort(list_t *list, void *e1, void *e2);
+
+/**
+ * @brief Add elements sorted to a list and print the result
+ * @param name Name of the benchmark
+ * @param inline_size Maximum size of the elements copied in the list element itself, 0 if not used
+ * @param size Number of elements
+ */
+static void bench_list(const char *name, size_t inline_size, size_t size);
+
+/**
+ * @brief Add elements sorted to a typed list and print the result
+ * @param size Number of elements
+ */
+static void bench_typed(size_t size);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Main function
+ * @return Always returns 0
+ */
+int
+main(void) {
+
+    static const size_t sizes[] = { 100, 1000, 10000 };
+
+    /* Add the same random elements sorted to the lists */
+    printf("%-10s %-10s %-10s\n", "list", "size", "ns/add");
+    for (size_t index = 0; index < sizeof(sizes) / sizeof(size_t); index++) {
+        bench_list("list", 0, sizes[index]);
+        bench_list("inline", sizeof(bench_item_t), sizes[index]);
+        bench_typed(sizes[index]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get monotonic time
+ * @return Monotonic time in nanoseconds
+ */
+static uint64_t
+bench_now(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Generate pseudo random number
+ * @param state State of the generator
+ * @return Pseudo random number
+ */
+static uint32_t
+bench_random(uint64_t *state) {
+
+    /* xorshift64 generator */
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return (uint32_t)(*state >> 32);
+}
+
+/**
+ * @brief Callback function used to sort elements of the list
+ * @param list List instance
+ * @param e1 First element
+ * @param e2 Second element
+ * @return true if e1 must be placed before e2, false otherwise
+ */
+static bool
+bench_sort(list_t *list, void *e1, void *e2) {
+
+    (void)list;
+
+    return ((bench_item_t *)e1)->key <= ((bench_item_t *)e2)->key;
+}
+
+/**
+ * @brief Add elements sorted to a list and print the result
+ * @param name Name of the benchmark
+ * @param inline_size Maximum size of the elements copied in the list element itself, 0 if not used
+ * @param size Number of elements
+ */
+static void
+bench_list(const char *name, size_t inline_size, size_t size) {
+
+    list_options_t options = { 0 };
+    options.lock           = LIST_LOCK_NONE;
+    options.inline_size    = inline_size;
+    uint64_t state         = 0x9e3779b97f4a7c15ULL;
+
+    /* Create list */
+    list_t *list = list_create_ext(true, bench_sort, &options);
+    if (NULL == list) {
+        printf("unable to create list instance\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Add elements */
+    uint64_t start = bench_now();
+    for (size_t index = 0; index < size; index++) {
+        bench_item_t item = { bench_random(&state), (uint32_t)index };
+        list_add(list, &item, sizeof(bench_item_t));
+    }
+    uint64_t duration = bench_now() - start;
+    printf("%-10s %-10zu %-10.1f\n", name, size, (double)duration / size);
+
+    /* Release memory */
+    list_release(list);
+}
+
+/**
+ * @brief Add elements sorted to a typed list and print the result
+ * @param size Number of elements
+ */
+static void
+bench_typed(size_t size) {
+
+    bench_items_t list;
+    uint64_t      state = 0x9e3779b97f4a7c15ULL;
+
+    /* Create list */
+    bench_items_init(&list);
+
+    /* Add elements */
+    uint64_t start = bench_now();
+    for (size_t index = 0; index < size; index++) {
+        bench_item_t item = { bench_random(&state), (uint32_t)index };
+        if (NULL == bench_items_add(&list, &item)) {
+            printf("unable to allocate memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    uint64_t duration = bench_now() - start;
+    printf("%-10s %-10zu %-10.1f\n", "typed", size, (double)duration / size);
+
+    /* Release memory */
+    bench_items_clear(&list);
+}
@@ -87,6 +87,7 @@ then using the LIST_API_VISIBILITY flag to "export" the same symbols the way LIS
 /* Includes                                                                   */
 /******************************************************************************/
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <semaphore.h>
@@ -95,6 +96,136 @@ then using the LIST_API_VISIBILITY flag to "export" the same symbols the way LIS
 /* Definitions                                                                */
 /******************************************************************************/
 
+/**
+ * List storage mode
+ */
+typedef enum {
+    LIST_MODE_LINKED = 0, /**< Elements are stored in a doubly linked list (default) */
+    LIST_MODE_HEAP        /**< Elements are stored in a binary heap ordered using the sort callback, only the head is ordered, other elements are in heap array order */
+} list_mode_t;
+
+/**
+ * List locking
+ */
+typedef enum {
+    LIST_LOCK_SEMAPHORE = 0, /**< Access to the list is protected using a semaphore (default) */
+    LIST_LOCK_NONE           /**< Access to the list is not protected, the caller is responsible of the synchronization */
+} list_lock_t;
+
+/**
+ * Operations of the list holding the semaphore, used to identify lock latency histograms
+ */
+typedef enum {
+    LIST_OP_ADD = 0,       /**< list_add, list_add_handle, list_add_ttl and list_add_shared */
+    LIST_OP_ADD_HEAD,      /**< list_add_head */
+    LIST_OP_ADD_TAIL,      /**< list_add_tail, list_add_owned and list_add_tail_owned */
+    LIST_OP_ADD_AT,        /**< list_add_at */
+    LIST_OP_ALLOC,         /**< Not used, list elements kept by list_clear or from the arena are allocated by the add operations */
+    LIST_OP_SET_EXPIRY,    /**< list_set_expiry */
+    LIST_OP_EXPIRE,        /**< list_expire */
+    LIST_OP_UPDATE_HANDLE, /**< list_update_handle */
+    LIST_OP_REMOVE_HANDLE, /**< list_remove_handle */
+    LIST_OP_MOVE_HEAD,     /**< list_move_head */
+    LIST_OP_MOVE_TAIL,     /**< list_move_tail */
+    LIST_OP_GET_COUNT,     /**< list_get_count */
+    LIST_OP_GET_HEAD,      /**< list_get_head */
+    LIST_OP_GET_TAIL,      /**< list_get_tail */
+    LIST_OP_GET_NEXT,      /**< list_get_next */
+    LIST_OP_GET_PREV,      /**< list_get_prev */
+    LIST_OP_GET_AT,        /**< list_get_at */
+    LIST_OP_GET_INDEX,     /**< list_get_index */
+    LIST_OP_REMOVE,        /**< list_remove */
+    LIST_OP_REMOVE_HEAD,   /**< list_remove_head */
+    LIST_OP_REMOVE_TAIL,   /**< list_remove_tail */
+    LIST_OP_REMOVE_AT,     /**< list_remove_at */
+    LIST_OP_MEMORY_STATS,  /**< list_memory_stats */
+    LIST_OP_TRIM,          /**< list_trim */
+    LIST_OP_CLEAR,         /**< list_clear */
+    LIST_OP_RESET,         /**< list_reset */
+    LIST_OP_RELEASE,       /**< list_release */
+    LIST_OP_RELEASE_ASYNC, /**< list_release_async */
+    LIST_OP_FREE_ELEMENT,  /**< list_free_element */
+    LIST_OP_ADD_BEFORE,    /**< list_add_before and list_emplace_before */
+    LIST_OP_MOVE_BEFORE,   /**< list_move_before */
+    LIST_OP_COUNT          /**< Number of operations */
+} list_op_t;
+
+/**
+ * List options
+ */
+typedef struct {
+    list_mode_t mode;              /**< Storage mode of the list */
+    list_lock_t lock;              /**< Locking of the list */
+    uint64_t (*clock)(void);       /**< Callback function returning the current time used to expire elements, NULL to use monotonic time in milliseconds */
+    bool indexed;                  /**< true to maintain an order statistic index of the elements for positional access, linked mode only */
+    bool arena;                    /**< true to allocate list elements in chunks owned by the list, memory is released by list_clear and list_release */
+    bool thread_cache;             /**< true to allocate list elements from per-thread caches, not allowed with arena or custom allocator */
+    const size_t *pools;           /**< Sizes of the pools of slots used to copy the elements, elements are copied in the smallest slots large enough, not allowed with arena, NULL if not used */
+    size_t        npools;          /**< Number of pools */
+    size_t        inline_size;     /**< Maximum size of the elements copied in the list element itself when alloc is true, not allowed with arena or above 64 bytes with thread_cache, 0 if not used */
+    bool          shared;          /**< true to share the copy of the elements between lists using a reference count when alloc is true, not allowed with pools or inline_size */
+    bool          ttl;             /**< true to store an expiry time in the list elements, required by list_add_ttl and list_set_expiry */
+} list_options_t;
+
+/**
+ * Usage of a pool of slots used to copy the elements
+ */
+typedef struct {
+    size_t size;  /**< Size of the slots of the pool */
+    size_t held;  /**< Number of bytes held by the pool */
+    size_t used;  /**< Number of bytes of the slots currently used */
+    size_t slots; /**< Number of slots currently used */
+} list_pool_usage_t;
+
+/**
+ * List allocator
+ */
+typedef struct {
+    void *(*alloc)(size_t size, void *ctx);           /**< Callback function invoked to allocate memory */
+    void (*free)(void *ptr, size_t size, void *ctx); /**< Callback function invoked to release memory, size is the size of the allocation */
+    void *ctx;                                        /**< User context given to the callback functions */
+} list_allocator_t;
+
+/**
+ * Memory usage of a list
+ */
+typedef struct {
+    size_t count;          /**< Number of elements of the list */
+    size_t node_bytes;     /**< Number of bytes of the list elements */
+    size_t payload_bytes;  /**< Number of bytes of the copy of the elements, including elements copied in the list elements, the arena or the pools */
+    size_t cached_bytes;   /**< Number of bytes kept for future allocations, list elements kept by list_clear and free slots of the pools */
+    size_t arena_bytes;    /**< Number of bytes of the chunks of the arena */
+    size_t pool_bytes;     /**< Number of bytes of the blocks of the pools */
+    size_t overhead_bytes; /**< Number of bytes of the list instance, the heap array and the pools */
+} list_memory_stats_t;
+
+/**
+ * Operation and contention statistics of a list, collected when the library is built with LIST_STATS
+ */
+typedef struct {
+    uint64_t adds;              /**< Number of elements linked in the list, moving an element counts as one add and one remove */
+    uint64_t removes;           /**< Number of elements unlinked from the list */
+    uint64_t traversal_steps;   /**< Number of elements reached using list_get_head, list_get_tail, list_get_next and list_get_prev */
+    uint64_t sort_calls;        /**< Number of invocations of the sort callback */
+    uint64_t remove_scans;      /**< Number of searches performed by list_remove */
+    uint64_t remove_scan_steps; /**< Number of elements compared by list_remove */
+    uint64_t lock_acquisitions; /**< Number of acquisitions of the semaphore */
+    uint64_t lock_contentions;  /**< Number of acquisitions of the semaphore which had to wait */
+    uint64_t lock_wait_ns;      /**< Time spent waiting for the semaphore, in nanoseconds */
+} list_stats_t;
+
+/**
+ * Latency percentiles of an operation, in nanoseconds, collected when the library is built with LIST_HISTOGRAMS
+ */
+typedef struct {
+    uint64_t count; /**< Number of samples */
+    uint64_t p50;   /**< Median */
+    uint64_t p90;   /**< 90th percentile */
+    uint64_t p99;   /**< 99th percentile */
+    uint64_t p999;  /**< 99.9th percentile */
+    uint64_t max;   /**< Maximum */
+} list_latency_t;
+
 /**
  * List element
  */
@@ -114,7 +245,36 @@ typedef struct list_s {
     size_t          count;                         /**< Number of elements in the list */
     bool            alloc;                         /**< Flag to indicate if elements are allocated when they are added in the list */
     bool (*sort)(struct list_s *, void *, void *); /**< Callback function invoked to sort elements of the list, NULL if not used */
-    sem_t sem;                                     /**< Semaphore used to protect the access to the list */
+    sem_t            sem;                          /**< Semaphore used to protect the access to the list */
+    list_mode_t      mode;                         /**< Storage mode of the list */
+    list_element_t **heap;                         /**< Array of elements of the heap, heap mode only */
+    size_t           capacity;                     /**< Capacity of the heap array, heap mode only */
+    list_lock_t      lock;                         /**< Locking of the list */
+    uint64_t (*clock)(void);                       /**< Callback function returning the current time used to expire elements */
+    size_t               expiring;                 /**< Number of elements of the list with an expiry time */
+    list_element_t *     sweep;                    /**< Next element checked when expiring elements of the list */
+    bool                 indexed;                  /**< Flag to indicate if the order statistic index is maintained */
+    struct list_rank_s * root;                     /**< Root node of the order statistic index of the list */
+    bool                 arena;                    /**< Flag to indicate if list elements are allocated in chunks owned by the list */
+    struct list_chunk_s *chunks;                   /**< Chunks of memory of the arena of the list, arena only */
+    list_allocator_t     allocator;                /**< Allocator of the list elements */
+    bool                 thread_cache;             /**< Flag to indicate if list elements are allocated from per-thread caches */
+    struct list_pools_s *pools;                    /**< Pools of slots used to copy the elements, NULL if not used */
+    size_t               node_size;                /**< Size of the list elements, including the fields required by the options of the list */
+    size_t               pos_offset;               /**< Offset of the position in the heap in the list elements, heap mode only */
+    size_t               expiry_offset;            /**< Offset of the expiry time in the list elements, 0 if not stored */
+    size_t               copy_offset;              /**< Offset of the size of the copy of the element in the list elements, 0 if elements are not allocated */
+    size_t               inline_size;              /**< Maximum size of the elements copied in the list element itself, 0 if not used */
+    bool                 shared;                   /**< Flag to indicate if the copy of the elements are shared between lists */
+    struct list_s *      reclaim;                  /**< Next list to be released asynchronously */
+    list_element_t *     cache;                    /**< List elements kept by list_clear for future allocations */
+    list_element_t *     detached;                 /**< List elements of the elements allocated by the caller removed from the list, kept until list_free_element is called */
+    size_t               cached;                   /**< Number of list elements kept for future allocations */
+    size_t               bytes;                    /**< Number of bytes of the copy of the elements of the list */
+    bool                 instrumented;             /**< Flag to indicate if the library is built with LIST_STATS or LIST_USDT */
+    list_stats_t         stats;                    /**< Operation and contention statistics of the list, updated only when the library is built with LIST_STATS */
+    uint64_t             hold_start;               /**< Time at which the semaphore has been acquired, in nanoseconds, LIST_HISTOGRAMS or LIST_USDT only */
+    list_op_t            hold_op;                  /**< Operation holding the semaphore, LIST_HISTOGRAMS or LIST_USDT only */
 } list_t;
 
 /******************************************************************************/
@@ -129,6 +289,28 @@ typedef struct list_s {
  */
 LIST_PUBLIC(list_t *) list_create(bool alloc, bool (*sort)(list_t *, void *, void *));
 
+/**
+ * @brief Function used to create list instance with options
+ * @param alloc true if element should be allocated when they are added in the list, false for a copy only
+ * @param sort Callback function invoked to sort elements of the list, NULL if not used (mandatory in heap mode)
+ * @param options List options, NULL to use default options
+ * @return List instance if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_t *) list_create_ext(bool alloc, bool (*sort)(list_t *, void *, void *), const list_options_t *options);
+
+/**
+ * @brief Function used to create list instance with options and allocator
+ * @param alloc true if element should be allocated when they are added in the list, false for a copy only
+ * @param sort Callback function invoked to sort elements of the list, NULL if not used (mandatory in heap mode)
+ * @param options List options, NULL to use default options
+ * @param allocator Allocator used for the list elements and the copy of the elements, NULL to use malloc and free
+ * @return List instance if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_t *) list_create_allocator(bool alloc,
+                                            bool (*sort)(list_t *, void *, void *),
+                                            const list_options_t *  options,
+                                            const list_allocator_t *allocator);
+
 /**
  * @brief Add element to the the list
  * @param list List instance
@@ -156,6 +338,143 @@ LIST_PUBLIC(int) list_add_head(list_t *list, void *e, size_t size);
  */
 LIST_PUBLIC(int) list_add_tail(list_t *list, void *e, size_t size);
 
+/**
+ * @brief Add element allocated by the caller to the list without copying it, the list takes ownership of the element
+ * @param list List instance
+ * @param e Element to be added in the list, allocated using the allocator of the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_add_owned(list_t *list, void *e, size_t size);
+
+/**
+ * @brief Add element allocated by the caller to the tail of the list without copying it, the list takes ownership of the element
+ * @param list List instance
+ * @param e Element to be added in the list, allocated using the allocator of the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_add_tail_owned(list_t *list, void *e, size_t size);
+
+/**
+ * @brief Add an element of another list to the list without copying it, both lists must share the copy of the elements
+ * @param list List instance
+ * @param e Element to be added in the list, the element is shared by the lists
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_add_shared(list_t *list, void *e);
+
+/**
+ * @brief Add element to the list and return its handle
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @return Handle of the element if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_element_t *) list_add_handle(list_t *list, void *e, size_t size);
+
+/**
+ * @brief Add element to the list with a time to live
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param ttl Time to live of the element, in the unit of the clock of the list
+ * @return 0 if the function succeeded, -1 otherwise, the list must be created with the ttl option
+ */
+LIST_PUBLIC(int) list_add_ttl(list_t *list, void *e, size_t size, uint64_t ttl);
+
+/**
+ * @brief Set expiry time of an element of the list using its handle, nothing is done if the list is not created with the ttl option
+ * @param list List instance
+ * @param handle Handle of the element
+ * @param expiry Expiry time of the element, in the unit of the clock of the list, 0 if the element never expires
+ */
+LIST_PUBLIC(void) list_set_expiry(list_t *list, list_element_t *handle, uint64_t expiry);
+
+/**
+ * @brief Get current time of the clock of the list
+ * @param list List instance
+ * @return Current time of the clock of the list
+ */
+LIST_PUBLIC(uint64_t) list_get_time(list_t *list);
+
+/**
+ * @brief Remove expired elements of the list, checking a bounded number of elements from where the previous call stopped
+ * @param list List instance
+ * @param now Current time, in the unit of the clock of the list
+ * @param budget Maximum number of elements checked, 0 to check all the elements of the list
+ * @return Number of elements removed
+ */
+LIST_PUBLIC(size_t) list_expire(list_t *list, uint64_t now, size_t budget);
+
+/**
+ * @brief Update position of an element of the list after its sort key has been modified
+ * @param list List instance
+ * @param handle Handle of the element
+ */
+LIST_PUBLIC(void) list_update_handle(list_t *list, list_element_t *handle);
+
+/**
+ * @brief Remove element of the list using its handle
+ * @param list List instance
+ * @param handle Handle of the element
+ */
+LIST_PUBLIC(void) list_remove_handle(list_t *list, list_element_t *handle);
+
+/**
+ * @brief Add element to the list at the wanted position, not available in heap mode
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param index Position of the element in the list, from 0 to the number of elements of the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_add_at(list_t *list, void *e, size_t size, size_t index);
+
+/**
+ * @brief Add element to the list just before another element using its handle and return the handle of the new element, not available in heap mode
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param next Handle of the element before which the element is added, NULL to add the element to the tail of the list
+ * @return Handle of the element if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_element_t *) list_add_before(list_t *list, void *e, size_t size, list_element_t *next);
+
+/**
+ * @brief Add an element stored in the list element itself just before another element using its handle and return the handle of the new element, the element is not initialized, not available in heap mode
+ * @param list List instance, created with alloc true and an inline_size option of at least size
+ * @param size Size of the element to be added
+ * @param next Handle of the element before which the element is added, NULL to add the element to the tail of the list
+ * @return Handle of the element if the function succeeded, the e field of the handle is the storage of the element, NULL otherwise
+ */
+LIST_PUBLIC(list_element_t *) list_emplace_before(list_t *list, size_t size, list_element_t *next);
+
+/**
+ * @brief Move element of the list to the head of the list using its handle, not available in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_move_head(list_t *list, list_element_t *handle);
+
+/**
+ * @brief Move element of the list to the tail of the list using its handle, not available in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_move_tail(list_t *list, list_element_t *handle);
+
+/**
+ * @brief Move element of the list just before another element using their handles, not available in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @param next Handle of the element before which the element is moved, NULL to move the element to the tail of the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_move_before(list_t *list, list_element_t *handle, list_element_t *next);
+
 /**
  * @brief Get number of element in the list
  * @param list List instance
@@ -164,33 +483,49 @@ LIST_PUBLIC(int) list_add_tail(list_t *list, void *e, size_t size);
 LIST_PUBLIC(size_t) list_get_count(list_t *list);
 
 /**
- * @brief Get head element of the list
+ * @brief Get head element of the list, first element of the ordering in heap mode
  * @param list List instance
  * @return Head element of the list, NULL if the list is empty
  */
 LIST_PUBLIC(void *) list_get_head(list_t *list);
 
 /**
- * @brief Get tail element of the list
+ * @brief Get tail element of the list, last element of the heap array in heap mode which is not the last element of the ordering
  * @param list List instance
  * @return Tail element of the list, NULL if the list is empty
  */
 LIST_PUBLIC(void *) list_get_tail(list_t *list);
 
 /**
- * @brief Get next element of the list
+ * @brief Get next element of the list, next element of the heap array in heap mode
  * @param list List instance
  * @return Next element of the list, NULL if the end of the list is reached
  */
 LIST_PUBLIC(void *) list_get_next(list_t *list);
 
 /**
- * @brief Get previous element of the list
+ * @brief Get previous element of the list, previous element of the heap array in heap mode
  * @param list List instance
  * @return Previous element of the list, NULL if the beginning of the list is reached
  */
 LIST_PUBLIC(void *) list_get_prev(list_t *list);
 
+/**
+ * @brief Get element of the list at the wanted position, the element becomes the current element of the list, position in the heap array in heap mode
+ * @param list List instance
+ * @param index Position of the element in the list
+ * @return Element of the list, NULL if the position is out of the list
+ */
+LIST_PUBLIC(void *) list_get_at(list_t *list, size_t index);
+
+/**
+ * @brief Get position of an element of the list using its handle, position in the heap array in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @return Position of the element in the list
+ */
+LIST_PUBLIC(size_t) list_get_index(list_t *list, list_element_t *handle);
+
 /**
  * @brief Remove element of the list
  * @param list List instance
@@ -199,25 +534,134 @@ LIST_PUBLIC(void *) list_get_prev(list_t *list);
 LIST_PUBLIC(void *) list_remove(list_t *list, void *e);
 
 /**
- * @brief Remove head element of the list
+ * @brief Remove head element of the list, first element of the ordering in heap mode
  * @param list List instance
  * @return Head element of the list, NULL if the list is empty
  */
 LIST_PUBLIC(void *) list_remove_head(list_t *list);
 
 /**
- * @brief Remove tail element of the list
+ * @brief Remove tail element of the list, last element of the heap array in heap mode which is not the last element of the ordering
  * @param list List instance
  * @return Tail element of the list, NULL if the list is empty
  */
 LIST_PUBLIC(void *) list_remove_tail(list_t *list);
 
+/**
+ * @brief Remove element of the list at the wanted position, position in the heap array in heap mode
+ * @param list List instance
+ * @param index Position of the element in the list
+ * @return Element of the list, NULL if the position is out of the list
+ */
+LIST_PUBLIC(void *) list_remove_at(list_t *list, size_t index);
+
+/**
+ * @brief Release an element returned by list_remove_head, list_remove_tail or list_remove_at when elements are allocated
+ * @param list List instance
+ * @param e Element to be released, elements added using list_add_owned or list_add_tail_owned are released using the allocator of the list and their own size
+ * @param size Size of the element, not used for elements allocated by the caller
+ */
+LIST_PUBLIC(void) list_free_element(list_t *list, void *e, size_t size);
+
+/**
+ * @brief Get usage of the pools of slots used to copy the elements
+ * @param list List instance
+ * @param usage Array filled with the usage of the pools
+ * @param count Size of the array
+ * @return Number of pools of the list
+ */
+LIST_PUBLIC(size_t) list_get_pool_usage(list_t *list, list_pool_usage_t *usage, size_t count);
+
+/**
+ * @brief Get memory usage of the list
+ * @param list List instance
+ * @param stats Memory usage of the list
+ */
+LIST_PUBLIC(void) list_memory_stats(list_t *list, list_memory_stats_t *stats);
+
+/**
+ * @brief Release memory kept by the list for future allocations
+ * @param list List instance
+ * @return Number of bytes released
+ */
+LIST_PUBLIC(size_t) list_trim(list_t *list);
+
+/**
+ * @brief Get operation and contention statistics of the list
+ * @param list List instance
+ * @param stats Statistics of the list, set to zero if statistics are not available
+ * @return 0 if the function succeeded, -1 if the library is built without LIST_STATS
+ */
+LIST_PUBLIC(int) list_get_stats(list_t *list, list_stats_t *stats);
+
+/**
+ * @brief Reset operation and contention statistics of the list
+ * @param list List instance
+ */
+LIST_PUBLIC(void) list_reset_stats(list_t *list);
+
+/**
+ * @brief Get lock latency percentiles of an operation, for all the lists
+ * @param op Operation
+ * @param wait Percentiles of the time spent waiting for the semaphore, set to zero if histograms are not available
+ * @param hold Percentiles of the time the semaphore is held, set to zero if histograms are not available
+ * @return 0 if the function succeeded, -1 if the library is built without LIST_HISTOGRAMS
+ */
+LIST_PUBLIC(int) list_get_latency(list_op_t op, list_latency_t *wait, list_latency_t *hold);
+
+/**
+ * @brief Print lock latency percentiles of all the operations
+ * @param stream Output stream
+ */
+LIST_PUBLIC(void) list_dump_latency(FILE *stream);
+
+/**
+ * @brief Reset lock latency histograms of all the operations
+ */
+LIST_PUBLIC(void) list_reset_latency(void);
+
+/**
+ * @brief Remove all elements of the list, memory of the list elements is kept for future allocations
+ * @param list List instance
+ */
+LIST_PUBLIC(void) list_clear(list_t *list);
+
+/**
+ * @brief Remove all elements of the list and release all the memory held by the list, options of the list are kept
+ * @param list List instance
+ */
+LIST_PUBLIC(void) list_reset(list_t *list);
+
 /**
  * @brief Release list instance
  * @param list List instance
  */
 LIST_PUBLIC(void) list_release(list_t *list);
 
+/**
+ * @brief Release list instance asynchronously, elements of the list are released by list_reclaim or by the reclaim thread
+ * @param list List instance
+ */
+LIST_PUBLIC(void) list_release_async(list_t *list);
+
+/**
+ * @brief Release elements of the lists released asynchronously
+ * @param budget Maximum number of elements released, 0 to release all the elements
+ * @return Number of elements released
+ */
+LIST_PUBLIC(size_t) list_reclaim(size_t budget);
+
+/**
+ * @brief Start the reclaim thread releasing elements of the lists released asynchronously
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_reclaim_start(void);
+
+/**
+ * @brief Stop the reclaim thread, remaining elements of the lists released asynchronously are released before the thread exits
+ */
+LIST_PUBLIC(void) list_reclaim_stop(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,621 @@
+/**
+ * @file      list.hpp
+ * @brief     C++ wrapper of the list library
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __LIST_HPP__
+#define __LIST_HPP__
+
+#if __cplusplus < 201703L
+#error "list.hpp requires C++17"
+#endif
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "list.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+namespace clist {
+
+/**
+ * Locking policy without locking, the caller is responsible of the synchronization
+ */
+struct no_lock {
+    static constexpr bool enabled = false; /**< Locking is compiled out */
+    void                  lock() noexcept {
+    }
+    void unlock() noexcept {
+    }
+};
+
+/**
+ * Locking policy protecting the modifications of the list using a mutex
+ */
+struct mutex_lock {
+    static constexpr bool enabled = true; /**< Locking is enabled */
+    void                  lock() {
+        mutex.lock();
+    }
+    void unlock() {
+        mutex.unlock();
+    }
+    std::mutex mutex; /**< Mutex used to protect the list */
+};
+
+/**
+ * List of elements of type T, elements are constructed in place in the list elements of a list_t, so each element costs a single allocation
+ *
+ * The list elements of the C library are allocated using Alloc, the elements are constructed and destroyed using Alloc. The comparator Compare
+ * is used by insert_sorted and emplace_sorted and is inlined in the search of the position of the new element. Lock selects at compile time if
+ * the modifications of the list are protected, the iterators and the references to the elements are not protected. The list_t is created with
+ * the first element added to the list.
+ */
+template <typename T, typename Alloc = std::allocator<T>, typename Compare = std::less<T>, typename Lock = no_lock>
+class list {
+
+  private:
+    /**
+     * Elements are stored in the list elements of the C library, aligned on two pointers
+     */
+    static_assert((alignof(T) <= alignof(std::max_align_t)) && (alignof(T) <= 2 * sizeof(void *)), "alignment of the elements is not supported");
+
+    /**
+     * Allocator constructing the elements and allocator of the list elements of the C library, memory of the list elements is allocated in units of max_align_t
+     */
+    using element_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using element_traits    = std::allocator_traits<element_allocator>;
+    using block_allocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<std::max_align_t>;
+    using block_traits      = std::allocator_traits<block_allocator>;
+
+    /**
+     * Context of the allocator of the C library, allocated separately so that its address does not change when the list is moved
+     */
+    struct context {
+        block_allocator blocks; /**< Allocator of the list elements */
+    };
+
+    /**
+     * Guard of the locking policy
+     */
+    class guard {
+      public:
+        explicit guard(Lock &lock) : lock_(lock) {
+            if constexpr (Lock::enabled) {
+                lock_.lock();
+            }
+        }
+        ~guard() {
+            if constexpr (Lock::enabled) {
+                lock_.unlock();
+            }
+        }
+        guard(const guard &)            = delete;
+        guard &operator=(const guard &) = delete;
+
+      private:
+        Lock &lock_; /**< Locking policy */
+    };
+
+  public:
+    /**
+     * Bidirectional iterator over the elements of the list
+     */
+    template <bool Const>
+    class basic_iterator {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+
+        basic_iterator() noexcept = default;
+        basic_iterator(list_element_t *node, list_t *owner) noexcept : node_(node), owner_(owner) {
+        }
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &other) noexcept : node_(other.node_), owner_(other.owner_) {
+        }
+
+        reference operator*() const noexcept {
+            return *static_cast<pointer>(node_->e);
+        }
+        pointer operator->() const noexcept {
+            return static_cast<pointer>(node_->e);
+        }
+        basic_iterator &operator++() noexcept {
+            node_ = node_->next;
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            basic_iterator tmp = *this;
+            node_              = node_->next;
+            return tmp;
+        }
+        basic_iterator &operator--() noexcept {
+            if (nullptr != node_) {
+                node_ = node_->prev;
+            } else if (nullptr != owner_) {
+                node_ = owner_->last;
+            }
+            return *this;
+        }
+        basic_iterator operator--(int) noexcept {
+            basic_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) noexcept {
+            return a.node_ == b.node_;
+        }
+        friend bool operator!=(const basic_iterator &a, const basic_iterator &b) noexcept {
+            return a.node_ != b.node_;
+        }
+
+      private:
+        friend class list;
+        friend class basic_iterator<true>;
+        list_element_t *node_  = nullptr; /**< List element, nullptr for the end of the list */
+        list_t *        owner_ = nullptr; /**< List instance, used to decrement the end of the list, nullptr if no element has been added yet */
+    };
+
+    using value_type             = T;
+    using allocator_type         = Alloc;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using iterator               = basic_iterator<false>;
+    using const_iterator         = basic_iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Create an empty list, no memory is allocated until an element is added
+     * @param alloc Allocator
+     * @param compare Comparator used by insert_sorted and emplace_sorted
+     */
+    explicit list(const Alloc &alloc = Alloc(), const Compare &compare = Compare()) : alloc_(alloc), compare_(compare) {
+    }
+
+    /**
+     * @brief Create a list with copies of the elements of another list
+     * @param other List copied
+     */
+    list(const list &other)
+        : alloc_(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc_)), compare_(other.compare_) {
+        for (const T &e : other) {
+            emplace_back(e);
+        }
+    }
+
+    /**
+     * @brief Create a list taking the elements of another list, the other list is left empty
+     * @param other List moved
+     */
+    list(list &&other) noexcept
+        : alloc_(other.alloc_), compare_(other.compare_), list_(std::exchange(other.list_, nullptr)), context_(std::exchange(other.context_, nullptr)) {
+    }
+
+    /**
+     * @brief Release the elements and the list
+     */
+    ~list() {
+        release();
+    }
+
+    /**
+     * @brief Replace the elements of the list with copies of the elements of another list
+     * @param other List copied
+     * @return List
+     */
+    list &operator=(const list &other) {
+        if (this != &other) {
+            list tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Replace the elements of the list with the elements of another list, the other list is left empty
+     * @param other List moved
+     * @return List
+     */
+    list &operator=(list &&other) noexcept {
+        if (this != &other) {
+            release();
+            alloc_   = other.alloc_;
+            compare_ = other.compare_;
+            list_    = std::exchange(other.list_, nullptr);
+            context_ = std::exchange(other.context_, nullptr);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Exchange the elements of two lists
+     * @param other Other list
+     */
+    void swap(list &other) noexcept {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        swap(compare_, other.compare_);
+        swap(list_, other.list_);
+        swap(context_, other.context_);
+    }
+
+    /**
+     * @brief Get allocator of the list
+     * @return Allocator
+     */
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+    /**
+     * @brief Get list instance of the C library, nullptr if no element has been added yet
+     * @return List instance
+     */
+    list_t *native_handle() const noexcept {
+        return list_;
+    }
+
+    /**
+     * @brief Iterators of the list
+     */
+    iterator begin() noexcept {
+        return iterator((nullptr != list_) ? list_->first : nullptr, list_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator((nullptr != list_) ? list_->first : nullptr, list_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    iterator end() noexcept {
+        return iterator(nullptr, list_);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(nullptr, list_);
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Get number of elements of the list
+     * @return Number of elements of the list
+     */
+    size_type size() const noexcept {
+        return (nullptr != list_) ? list_->count : 0;
+    }
+
+    /**
+     * @brief Check if the list is empty
+     * @return true if the list is empty, false otherwise
+     */
+    bool empty() const noexcept {
+        return 0 == size();
+    }
+
+    /**
+     * @brief Access to the first and to the last elements of the list, the list must not be empty
+     */
+    reference front() {
+        return *begin();
+    }
+    const_reference front() const {
+        return *begin();
+    }
+    reference back() {
+        return *std::prev(end());
+    }
+    const_reference back() const {
+        return *std::prev(end());
+    }
+
+    /**
+     * @brief Construct an element in place before an element of the list
+     * @param pos Position of the element before which the new element is added
+     * @param args Arguments of the constructor of the element
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        guard lock(lock_);
+        return construct(pos.node_, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Add a copy of an element, or move an element, before an element of the list
+     * @param pos Position of the element before which the new element is added
+     * @param value Element
+     * @return Iterator to the new element
+     */
+    iterator insert(const_iterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+    iterator insert(const_iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+     * @brief Construct an element in place at the head or at the tail of the list
+     * @param args Arguments of the constructor of the element
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    reference emplace_front(Args &&...args) {
+        guard lock(lock_);
+        return *construct((nullptr != list_) ? list_->first : nullptr, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    reference emplace_back(Args &&...args) {
+        guard lock(lock_);
+        return *construct(nullptr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Add a copy of an element, or move an element, at the head or at the tail of the list
+     * @param value Element
+     */
+    void push_front(const T &value) {
+        emplace_front(value);
+    }
+    void push_front(T &&value) {
+        emplace_front(std::move(value));
+    }
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * @brief Construct an element in place before the first element of the list for which Compare returns true, equivalent elements are kept in insertion order
+     *
+     * The element is constructed at the tail of the list and then moved before the first element for which Compare returns true.
+     * @param args Arguments of the constructor of the element
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator emplace_sorted(Args &&...args) {
+        guard           lock(lock_);
+        iterator        it   = construct(nullptr, std::forward<Args>(args)...);
+        list_element_t *next = list_->first;
+        while ((it.node_ != next) && (false == compare_(*it, *static_cast<T *>(next->e)))) {
+            next = next->next;
+        }
+        if (it.node_ != next) {
+            list_move_before(list_, it.node_, next);
+        }
+        return it;
+    }
+
+    /**
+     * @brief Add a copy of an element, or move an element, before the first element of the list for which Compare returns true
+     * @param value Element
+     * @return Iterator to the new element
+     */
+    iterator insert_sorted(const T &value) {
+        return emplace_sorted(value);
+    }
+    iterator insert_sorted(T &&value) {
+        return emplace_sorted(std::move(value));
+    }
+
+    /**
+     * @brief Remove an element of the list
+     * @param pos Position of the element, must not be the end of the list
+     * @return Iterator to the element following the removed element
+     */
+    iterator erase(const_iterator pos) {
+        guard           lock(lock_);
+        list_element_t *next = pos.node_->next;
+        unlink(pos.node_);
+        return iterator(next, list_);
+    }
+
+    /**
+     * @brief Remove the first or the last element of the list, nothing is done if the list is empty
+     */
+    void pop_front() {
+        guard lock(lock_);
+        if ((nullptr != list_) && (nullptr != list_->first)) {
+            unlink(list_->first);
+        }
+    }
+    void pop_back() {
+        guard lock(lock_);
+        if ((nullptr != list_) && (nullptr != list_->last)) {
+            unlink(list_->last);
+        }
+    }
+
+    /**
+     * @brief Remove all the elements of the list, list elements of the C library are kept for future additions
+     */
+    void clear() {
+        guard lock(lock_);
+        if (nullptr != list_) {
+            destroy_elements();
+            list_clear(list_);
+        }
+    }
+
+  private:
+    /**
+     * @brief Add a list element and construct the element in its storage, the list is created if required, the list must be locked
+     * @param next List element before which the element is added, nullptr to add the element to the tail of the list
+     * @param args Arguments of the constructor of the element
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator construct(list_element_t *next, Args &&...args) {
+        list_element_t *handle = nullptr;
+        if ((nullptr != list_) || (true == create())) {
+            handle = list_emplace_before(list_, sizeof(T), next);
+        }
+        if (nullptr == handle) {
+            throw std::bad_alloc();
+        }
+        element_allocator alloc(alloc_);
+        try {
+            element_traits::construct(alloc, static_cast<T *>(handle->e), std::forward<Args>(args)...);
+        } catch (...) {
+            list_remove_handle(list_, handle);
+            throw;
+        }
+        return iterator(handle, list_);
+    }
+
+    /**
+     * @brief Destroy an element, its storage is released with the list element
+     * @param e Element
+     */
+    void destroy(T *e) noexcept {
+        element_allocator alloc(alloc_);
+        element_traits::destroy(alloc, e);
+    }
+
+    /**
+     * @brief Destroy an element and remove it from the list, the list must be locked
+     * @param handle List element
+     */
+    void unlink(list_element_t *handle) noexcept {
+        destroy(static_cast<T *>(handle->e));
+        list_remove_handle(list_, handle);
+    }
+
+    /**
+     * @brief Destroy all the elements of the list, the list must be locked
+     */
+    void destroy_elements() noexcept {
+        for (list_element_t *node = list_->first; nullptr != node; node = node->next) {
+            destroy(static_cast<T *>(node->e));
+        }
+    }
+
+    /**
+     * @brief Create the list instance of the C library, the list elements are allocated using the allocator of the list and store the elements
+     * @return true if the function succeeded, false otherwise
+     */
+    bool create() {
+        context_ = new (std::nothrow) context{ block_allocator(alloc_) };
+        if (nullptr == context_) {
+            return false;
+        }
+        list_options_t   options   = {};
+        list_allocator_t allocator = { &list::alloc_blocks, &list::free_blocks, context_ };
+        options.lock               = LIST_LOCK_NONE;
+        options.inline_size        = sizeof(T);
+        list_                      = list_create_allocator(true, nullptr, &options, &allocator);
+        if (nullptr == list_) {
+            delete context_;
+            context_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Release the elements and the list instance of the C library
+     */
+    void release() noexcept {
+        if (nullptr != list_) {
+            destroy_elements();
+            list_release(list_);
+            list_ = nullptr;
+        }
+        delete context_;
+        context_ = nullptr;
+    }
+
+    /**
+     * @brief Callback functions of the allocator of the C library
+     */
+    static std::size_t blocks(std::size_t size) noexcept {
+        return (size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+    }
+    static void *alloc_blocks(std::size_t size, void *ctx) {
+        try {
+            return block_traits::allocate(static_cast<context *>(ctx)->blocks, blocks(size));
+        } catch (...) {
+            return nullptr;
+        }
+    }
+    static void free_blocks(void *ptr, std::size_t size, void *ctx) {
+        block_traits::deallocate(static_cast<context *>(ctx)->blocks, static_cast<std::max_align_t *>(ptr), blocks(size));
+    }
+
+    Alloc    alloc_;             /**< Allocator of the list */
+    Compare  compare_;           /**< Comparator of the elements */
+    list_t * list_    = nullptr; /**< List instance of the C library, nullptr until an element is added */
+    context *context_ = nullptr; /**< Context of the allocator of the C library */
+    Lock     lock_;              /**< Locking policy */
+};
+
+/**
+ * @brief Exchange the elements of two lists
+ * @param a First list
+ * @param b Second list
+ */
+template <typename T, typename Alloc, typename Compare, typename Lock>
+void
+swap(list<T, Alloc, Compare, Lock> &a, list<T, Alloc, Compare, Lock> &b) noexcept {
+    a.swap(b);
+}
+
+} // namespace clist
+
+#endif /* __LIST_HPP__ */
@@ -0,0 +1,153 @@
+/**
+ * @file      list_inline.h
+ * @brief     Inline accessors of the list library
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __LIST_INLINE_H__
+#define __LIST_INLINE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "list.h"
+
+/******************************************************************************/
+/* Inline functions                                                           */
+/******************************************************************************/
+
+/*
+ * The accessors below parse the list directly when the list is not locked (LIST_LOCK_NONE), is in linked mode and has no element with an
+ * expiry time. They invoke the functions of the library otherwise, so the result is always the same as the result of the library functions.
+ * They invoke the functions of the library when the library is built with LIST_STATS or LIST_USDT so that statistics and probes are not lost.
+ * This is checked at runtime using the instrumented flag set by the library, the build flags of the application including this header are not relevant.
+ */
+
+/**
+ * @brief Check if the list can be accessed directly
+ * @param list List instance
+ * @return true if the list can be accessed directly, false otherwise
+ */
+static inline bool
+list_inline_direct(const list_t *list) {
+
+    return (false == list->instrumented) && (LIST_LOCK_NONE == list->lock) && (LIST_MODE_LINKED == list->mode) && (0 == list->expiring);
+}
+
+/**
+ * @brief Get number of elements of the list
+ * @param list List instance
+ * @return Number of elements of the list
+ */
+static inline size_t
+list_inline_get_count(list_t *list) {
+
+    if (true == list_inline_direct(list)) {
+        return list->count;
+    }
+
+    return list_get_count(list);
+}
+
+/**
+ * @brief Get head element of the list
+ * @param list List instance
+ * @return Head element of the list, NULL if the list is empty
+ */
+static inline void *
+list_inline_get_head(list_t *list) {
+
+    if (true == list_inline_direct(list)) {
+        list->curr = list->first;
+        return (NULL != list->curr) ? list->curr->e : NULL;
+    }
+
+    return list_get_head(list);
+}
+
+/**
+ * @brief Get tail element of the list
+ * @param list List instance
+ * @return Tail element of the list, NULL if the list is empty
+ */
+static inline void *
+list_inline_get_tail(list_t *list) {
+
+    if (true == list_inline_direct(list)) {
+        list->curr = list->last;
+        return (NULL != list->curr) ? list->curr->e : NULL;
+    }
+
+    return list_get_tail(list);
+}
+
+/**
+ * @brief Get next element of the list
+ * @param list List instance
+ * @return Next element of the list, NULL if the end of the list is reached
+ */
+static inline void *
+list_inline_get_next(list_t *list) {
+
+    if (true == list_inline_direct(list)) {
+        if (NULL != list->curr) {
+            list->curr = list->curr->next;
+        }
+        return (NULL != list->curr) ? list->curr->e : NULL;
+    }
+
+    return list_get_next(list);
+}
+
+/**
+ * @brief Get previous element of the list
+ * @param list List instance
+ * @return Previous element of the list, NULL if the beginning of the list is reached
+ */
+static inline void *
+list_inline_get_prev(list_t *list) {
+
+    if (true == list_inline_direct(list)) {
+        if (NULL != list->curr) {
+            list->curr = list->curr->prev;
+        }
+        return (NULL != list->curr) ? list->curr->e : NULL;
+    }
+
+    return list_get_prev(list);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIST_INLINE_H__ */
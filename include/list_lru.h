@@ -0,0 +1,174 @@
+/**
+ * @file      list_lru.h
+ * @brief     LRU cache library
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __LIST_LRU_H__
+#define __LIST_LRU_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+
+#include "list.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * LRU cache entry
+ */
+typedef struct list_lru_entry_s {
+    struct list_lru_entry_s *next;       /**< Next entry of the hash bucket */
+    list_element_t *         handle;     /**< Handle of the entry in the recency list */
+    uint64_t                 hash;       /**< Hash of the key */
+    void *                   key;        /**< Key of the entry */
+    size_t                   key_size;   /**< Size of the key */
+    void *                   value;      /**< Value of the entry */
+    size_t                   value_size; /**< Size of the value */
+} list_lru_entry_t;
+
+/**
+ * LRU cache instance
+ */
+typedef struct list_lru_s {
+    list_t *           list;      /**< Recency list, least recently used entry at the head of the list */
+    list_lru_entry_t **buckets;   /**< Hash buckets of the entries */
+    size_t             nbuckets;  /**< Number of hash buckets */
+    size_t             count;     /**< Number of entries in the cache */
+    size_t             bytes;     /**< Size of the keys and values of the entries in the cache */
+    size_t             max_count; /**< Maximum number of entries in the cache, 0 if not limited */
+    size_t             max_bytes; /**< Maximum size of the keys and values of the entries in the cache, 0 if not limited */
+    struct {
+        void (*fct)(struct list_lru_s *, void *, size_t, void *, size_t, void *); /**< Callback function invoked when an entry is evicted */
+        void *user;                                                               /**< User data passed to the callback */
+    } cb;                                                                         /**< Eviction callback */
+    sem_t sem;                                                                    /**< Semaphore used to protect the access to the cache */
+} list_lru_t;
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Function used to create LRU cache instance
+ * @param max_count Maximum number of entries in the cache, 0 if not limited
+ * @param max_bytes Maximum size of the keys and values of the entries in the cache, 0 if not limited
+ * @return LRU cache instance if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_lru_t *) list_lru_create(size_t max_count, size_t max_bytes);
+
+/**
+ * @brief Function used to create LRU cache instance with a custom allocator
+ * @param max_count Maximum number of entries in the cache, 0 if not limited
+ * @param max_bytes Maximum size of the keys and values of the entries in the cache, 0 if not limited
+ * @param allocator Allocator of the entries and of the elements of the recency list, NULL to use malloc
+ * @return LRU cache instance if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_lru_t *) list_lru_create_allocator(size_t max_count, size_t max_bytes, const list_allocator_t *allocator);
+
+/**
+ * @brief Register callback function invoked when an entry is evicted from the cache, after the entry has been removed and without holding the lock of the cache
+ * @param lru LRU cache instance
+ * @param fct Callback function, invoked with the cache, the key, the key size, the value, the value size and the user data
+ * @param user User data passed to the callback function
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_lru_on_evict(list_lru_t *lru, void (*fct)(list_lru_t *, void *, size_t, void *, size_t, void *), void *user);
+
+/**
+ * @brief Add or replace an entry of the cache, the entry becomes the most recently used
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @param value Value of the entry
+ * @param value_size Size of the value
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+LIST_PUBLIC(int) list_lru_put(list_lru_t *lru, void *key, size_t key_size, void *value, size_t value_size);
+
+/**
+ * @brief Get a copy of the value of an entry of the cache, the entry becomes the most recently used
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @param value Buffer where the value is copied, the value is truncated if it is larger than the buffer
+ * @param value_size Size of the buffer, set to the size of the value if the entry is in the cache
+ * @return 0 if the function succeeded, -1 if the entry is not in the cache
+ */
+LIST_PUBLIC(int) list_lru_get(list_lru_t *lru, void *key, size_t key_size, void *value, size_t *value_size);
+
+/**
+ * @brief Mark an entry of the cache as the most recently used
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @return 0 if the function succeeded, -1 if the entry is not in the cache
+ */
+LIST_PUBLIC(int) list_lru_touch(list_lru_t *lru, void *key, size_t key_size);
+
+/**
+ * @brief Remove an entry of the cache, the eviction callback is not invoked
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @return 0 if the function succeeded, -1 if the entry is not in the cache
+ */
+LIST_PUBLIC(int) list_lru_remove(list_lru_t *lru, void *key, size_t key_size);
+
+/**
+ * @brief Evict the least recently used entry of the cache
+ * @param lru LRU cache instance
+ * @return 0 if the function succeeded, -1 if the cache is empty
+ */
+LIST_PUBLIC(int) list_lru_evict(list_lru_t *lru);
+
+/**
+ * @brief Get number of entries in the cache
+ * @param lru LRU cache instance
+ * @return Number of entries in the cache
+ */
+LIST_PUBLIC(size_t) list_lru_get_count(list_lru_t *lru);
+
+/**
+ * @brief Release LRU cache instance, the eviction callback is not invoked
+ * @param lru LRU cache instance
+ */
+LIST_PUBLIC(void) list_lru_release(list_lru_t *lru);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIST_LRU_H__ */
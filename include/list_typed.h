@@ -0,0 +1,231 @@
+/**
+ * @file      list_typed.h
+ * @brief     Typed lists generated for an element type and a comparator
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __LIST_TYPED_H__
+#define __LIST_TYPED_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * @brief Declare a typed list
+ *
+ * The macro declares the types name_t (list) and name_node_t (node storing an element by value) and the following static inline functions:
+ *
+ *   void         name_init(name_t *list)                              Initialize an empty list
+ *   name_node_t *name_add(name_t *list, const type *e)                Add a copy of e before the first element e2 for which cmp(e, e2) is true
+ *   name_node_t *name_add_head(name_t *list, const type *e)           Add a copy of e to the head of the list
+ *   name_node_t *name_add_tail(name_t *list, const type *e)           Add a copy of e to the tail of the list
+ *   void         name_sort(name_t *list)                              Sort the elements of the list, the order of equal elements is kept
+ *   name_node_t *name_find(name_t *list, const type *e)               Find the first element e2 for which cmp(e, e2) and cmp(e2, e) are false
+ *   void         name_remove(name_t *list, name_node_t *node)         Remove and release a node of the list
+ *   bool         name_remove_head(name_t *list, type *e)              Remove head element of the list and copy it to e if not NULL
+ *   bool         name_remove_tail(name_t *list, type *e)              Remove tail element of the list and copy it to e if not NULL
+ *   void         name_clear(name_t *list)                             Remove and release all the elements of the list
+ *
+ * Add functions return the node of the element, NULL if memory can't be allocated. Nodes are parsed using list->first, list->last and the
+ * prev, next and e fields of the nodes. The comparator is a function or a macro called with two pointers to elements, returning true (any
+ * nonzero value) if the first element must be placed before the second, so that it can be inlined in the generated code. Access to the
+ * list is not protected.
+ *
+ * @param name Name of the list, prefix of the generated types and functions
+ * @param type Type of the elements
+ * @param cmp Comparator of the elements
+ */
+#define LIST_DECLARE(name, type, cmp)                                                              \
+                                                                                                   \
+    typedef struct name##_node_s {                                                                 \
+        struct name##_node_s *prev; /* Previous node of the list */                                \
+        struct name##_node_s *next; /* Next node of the list */                                    \
+        type                  e;    /* Element itself */                                           \
+    } name##_node_t;                                                                               \
+                                                                                                   \
+    typedef struct {                                                                               \
+        name##_node_t *first; /* First node of the list */                                         \
+        name##_node_t *last;  /* Last node of the list */                                          \
+        size_t         count; /* Number of elements in the list */                                 \
+    } name##_t;                                                                                    \
+                                                                                                   \
+    static inline void name##_init(name##_t *list) {                                               \
+        list->first = list->last = NULL;                                                           \
+        list->count              = 0;                                                              \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_node_t *name##_link(name##_t *list, const type *e, name##_node_t *next) { \
+        name##_node_t *node = (name##_node_t *)malloc(sizeof(name##_node_t));                      \
+        if (NULL == node) {                                                                        \
+            return NULL;                                                                           \
+        }                                                                                          \
+        node->e    = *e;                                                                           \
+        node->next = next;                                                                         \
+        node->prev = (NULL != next) ? next->prev : list->last;                                     \
+        if (NULL != node->prev) {                                                                  \
+            node->prev->next = node;                                                               \
+        } else {                                                                                   \
+            list->first = node;                                                                    \
+        }                                                                                          \
+        if (NULL != next) {                                                                        \
+            next->prev = node;                                                                     \
+        } else {                                                                                   \
+            list->last = node;                                                                     \
+        }                                                                                          \
+        list->count++;                                                                             \
+        return node;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_node_t *name##_add(name##_t *list, const type *e) {                       \
+        name##_node_t *next = list->first;                                                         \
+        while ((NULL != next) && (false == (cmp(e, &next->e)))) {                                  \
+            next = next->next;                                                                     \
+        }                                                                                          \
+        return name##_link(list, e, next);                                                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_node_t *name##_add_head(name##_t *list, const type *e) {                  \
+        return name##_link(list, e, list->first);                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_node_t *name##_add_tail(name##_t *list, const type *e) {                  \
+        return name##_link(list, e, NULL);                                                         \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_sort(name##_t *list) {                                               \
+        name##_node_t *head = list->first;                                                         \
+        for (size_t width = 1; width < list->count; width *= 2) {                                  \
+            name##_node_t *left = head;                                                            \
+            name##_node_t *tail = NULL;                                                            \
+            while (NULL != left) {                                                                 \
+                name##_node_t *right  = left;                                                      \
+                size_t         lcount = 0;                                                         \
+                size_t         rcount = width;                                                     \
+                while ((lcount < width) && (NULL != right)) {                                      \
+                    right = right->next;                                                           \
+                    lcount++;                                                                      \
+                }                                                                                  \
+                while ((0 < lcount) || ((0 < rcount) && (NULL != right))) {                        \
+                    name##_node_t *node;                                                           \
+                    bool           from_right = (0 < rcount) && (NULL != right);                   \
+                    if ((true == from_right) && (0 < lcount)) {                                    \
+                        from_right = (false != (cmp(&right->e, &left->e)));                        \
+                    }                                                                              \
+                    if (true == from_right) {                                                      \
+                        node  = right;                                                             \
+                        right = right->next;                                                       \
+                        rcount--;                                                                  \
+                    } else {                                                                       \
+                        node = left;                                                               \
+                        left = left->next;                                                         \
+                        lcount--;                                                                  \
+                    }                                                                              \
+                    if (NULL != tail) {                                                            \
+                        tail->next = node;                                                         \
+                    } else {                                                                       \
+                        head = node;                                                               \
+                    }                                                                              \
+                    tail = node;                                                                   \
+                }                                                                                  \
+                left = right;                                                                      \
+            }                                                                                      \
+            tail->next = NULL;                                                                     \
+        }                                                                                          \
+        list->first = head;                                                                        \
+        list->last  = NULL;                                                                        \
+        for (name##_node_t *node = head; NULL != node; node = node->next) {                        \
+            node->prev = list->last;                                                               \
+            list->last = node;                                                                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline name##_node_t *name##_find(name##_t *list, const type *e) {                      \
+        name##_node_t *node = list->first;                                                         \
+        while ((NULL != node) && ((false != (cmp(e, &node->e))) || (false != (cmp(&node->e, e))))) { \
+            node = node->next;                                                                     \
+        }                                                                                          \
+        return node;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_remove(name##_t *list, name##_node_t *node) {                        \
+        if (NULL != node->prev) {                                                                  \
+            node->prev->next = node->next;                                                         \
+        } else {                                                                                   \
+            list->first = node->next;                                                              \
+        }                                                                                          \
+        if (NULL != node->next) {                                                                  \
+            node->next->prev = node->prev;                                                         \
+        } else {                                                                                   \
+            list->last = node->prev;                                                               \
+        }                                                                                          \
+        list->count--;                                                                             \
+        free(node);                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_remove_head(name##_t *list, type *e) {                               \
+        if (NULL == list->first) {                                                                 \
+            return false;                                                                          \
+        }                                                                                          \
+        if (NULL != e) {                                                                           \
+            *e = list->first->e;                                                                   \
+        }                                                                                          \
+        name##_remove(list, list->first);                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_remove_tail(name##_t *list, type *e) {                               \
+        if (NULL == list->last) {                                                                  \
+            return false;                                                                          \
+        }                                                                                          \
+        if (NULL != e) {                                                                           \
+            *e = list->last->e;                                                                    \
+        }                                                                                          \
+        name##_remove(list, list->last);                                                           \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_clear(name##_t *list) {                                              \
+        while (NULL != list->first) {                                                              \
+            name##_remove(list, list->first);                                                      \
+        }                                                                                          \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIST_TYPED_H__ */
@@ -0,0 +1,140 @@
+/**
+ * @file      list_wheel.h
+ * @brief     Timer wheel library
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __LIST_WHEEL_H__
+#define __LIST_WHEEL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+
+#include "list.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Number of bits of the tick used to index the slots of a level of the wheel
+ */
+#define LIST_WHEEL_BITS (8)
+
+/**
+ * Number of slots per level of the wheel
+ */
+#define LIST_WHEEL_SLOTS (1 << LIST_WHEEL_BITS)
+
+/**
+ * Number of levels of the wheel
+ */
+#define LIST_WHEEL_LEVELS (4)
+
+/**
+ * Timer of the wheel
+ */
+typedef struct {
+    list_element_t element; /**< Element linking the timer in its slot, element.e is the user data of the timer */
+    uint64_t       expiry;  /**< Expiry tick of the timer */
+    size_t         level;   /**< Level of the wheel in which the timer is stored, LIST_WHEEL_LEVELS if the timer is due */
+} list_wheel_timer_t;
+
+/**
+ * Timer wheel instance
+ */
+typedef struct {
+    list_element_t slots[LIST_WHEEL_LEVELS][LIST_WHEEL_SLOTS]; /**< Slots of the levels of the wheel, head of circular chains of timers */
+    list_element_t due;                                        /**< Timers already due when they have been scheduled */
+    uint64_t       now;                                        /**< Current tick of the wheel */
+    size_t         count;                                      /**< Number of timers in the wheel */
+    size_t         pending[LIST_WHEEL_LEVELS];                 /**< Number of timers in each level of the wheel */
+    sem_t          sem;                                        /**< Semaphore used to protect the access to the wheel */
+} list_wheel_t;
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Function used to create timer wheel instance
+ * @param now Current tick
+ * @return Timer wheel instance if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_wheel_t *) list_wheel_create(uint64_t now);
+
+/**
+ * @brief Schedule a timer in the wheel
+ * @param wheel Timer wheel instance
+ * @param expiry Expiry tick of the timer
+ * @param e User data of the timer
+ * @return Timer if the function succeeded, NULL otherwise
+ */
+LIST_PUBLIC(list_wheel_timer_t *) list_wheel_schedule(list_wheel_t *wheel, uint64_t expiry, void *e);
+
+/**
+ * @brief Cancel a timer of the wheel, the timer must not have expired
+ * @param wheel Timer wheel instance
+ * @param timer Timer
+ * @return User data of the timer
+ */
+LIST_PUBLIC(void *) list_wheel_cancel(list_wheel_t *wheel, list_wheel_timer_t *timer);
+
+/**
+ * @brief Advance the wheel to the current tick and expire the due timers
+ * @param wheel Timer wheel instance
+ * @param now Current tick
+ * @param fct Callback function invoked with the wheel, the user data of the timer and the user data for each expired timer
+ * @param user User data passed to the callback function
+ * @return Number of expired timers
+ */
+LIST_PUBLIC(size_t) list_wheel_advance(list_wheel_t *wheel, uint64_t now, void (*fct)(list_wheel_t *, void *, void *), void *user);
+
+/**
+ * @brief Get number of timers in the wheel
+ * @param wheel Timer wheel instance
+ * @return Number of timers in the wheel
+ */
+LIST_PUBLIC(size_t) list_wheel_get_count(list_wheel_t *wheel);
+
+/**
+ * @brief Release timer wheel instance, the timers are cancelled
+ * @param wheel Timer wheel instance
+ */
+LIST_PUBLIC(void) list_wheel_release(list_wheel_t *wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIST_WHEEL_H__ */
@@ -34,560 +34,4143 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#ifdef LIST_USDT
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#endif
 
 #include "list.h"
 
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Increment a statistics counter of the list, compiled out when the library is built without LIST_STATS
+ */
+#ifdef LIST_STATS
+#define LIST_STATS_ADD(list, counter, value) __atomic_fetch_add(&(list)->stats.counter, (value), __ATOMIC_RELAXED)
+#else
+#define LIST_STATS_ADD(list, counter, value)
+#endif
+
+/**
+ * Tracing probes, the duration is measured only when a tracer is attached to the probe, using the semaphore of the probe
+ */
+#ifdef LIST_USDT
+#define LIST_PROBE_ENABLED(name) (0 != __builtin_expect(c_list_##name##_semaphore, 0))
+#define LIST_PROBE_START(name)   (LIST_PROBE_ENABLED(name) ? list_clock_ns() : 0)
+#define LIST_PROBE_END(name, list, count, op, start)                                     \
+    do {                                                                                  \
+        if (LIST_PROBE_ENABLED(name)) {                                                   \
+            STAP_PROBE4(c_list, name, (list), (count), list_clock_ns() - (start), (op)); \
+        }                                                                                 \
+    } while (0)
+#else
+#define LIST_PROBE_ENABLED(name)                     (false)
+#define LIST_PROBE_START(name)                       (0)
+#define LIST_PROBE_END(name, list, count, op, start) ((void)(list), (void)(count), (void)(op), (void)(start))
+#endif
+
+/**
+ * Lock latency is always measured when histograms are enabled, and only when a tracer is attached to the lock probes otherwise
+ */
+#if defined(LIST_HISTOGRAMS)
+#define LIST_LOCK_TIMED() (true)
+#else
+#define LIST_LOCK_TIMED() (LIST_PROBE_ENABLED(lock_acquire) || LIST_PROBE_ENABLED(lock_release))
+#endif
+
+/**
+ * Number of bits of the sub-buckets of the latency histograms, values are recorded with a relative precision of 1/8
+ */
+#define LIST_HISTOGRAM_SUB_BITS (3)
+
+/**
+ * Number of buckets of the latency histograms, values up to 2^41 nanoseconds are recorded, larger values are recorded in the last bucket
+ */
+#define LIST_HISTOGRAM_BUCKETS (40 << LIST_HISTOGRAM_SUB_BITS)
+
+/**
+ * Initial capacity of the heap array
+ */
+#define LIST_HEAP_INITIAL_CAPACITY (16)
+
+/**
+ * Size of the chunks of memory of the arena
+ */
+#define LIST_ARENA_CHUNK_SIZE (64 * 1024)
+
+/**
+ * Alignment of the memory allocated in the arena
+ */
+#define LIST_ARENA_ALIGN(size) (((size) + 2 * sizeof(void *) - 1) & ~(2 * sizeof(void *) - 1))
+
+/**
+ * Number of list elements moved at once between the per-thread caches and the global pool
+ */
+#define LIST_CACHE_BATCH (32)
+
+/**
+ * Maximum number of batches of list elements in the global pool, per size of list elements
+ */
+#define LIST_CACHE_POOL (64)
+
+/**
+ * Maximum size of the elements copied in the list element itself when per-thread caches are used
+ */
+#define LIST_INLINE_MAX (64)
+
+/**
+ * Number of sizes of list elements, with or without the optional fields and the element itself
+ */
+#define LIST_CACHE_CLASSES                                                                                                                                     \
+    ((LIST_ARENA_ALIGN(sizeof(list_element_t) + sizeof(list_rank_t) + sizeof(uint64_t) + sizeof(list_copy_t)) - LIST_ARENA_ALIGN(sizeof(list_element_t))       \
+      + LIST_INLINE_MAX)                                                                                                                                       \
+         / (2 * sizeof(void *))                                                                                                                                \
+     + 1)
+
+/**
+ * Optional fields stored just after the list element, at offsets depending on the options of the list
+ */
+#define LIST_RANK(list_element)         ((list_rank_t *)((unsigned char *)(list_element) + sizeof(list_element_t)))
+#define LIST_POS(list, list_element)    (*(size_t *)((unsigned char *)(list_element) + (list)->pos_offset))
+#define LIST_EXPIRY(list, list_element) (*(uint64_t *)((unsigned char *)(list_element) + (list)->expiry_offset))
+#define LIST_COPY(list, list_element)   ((list_copy_t *)((unsigned char *)(list_element) + (list)->copy_offset))
+
+/**
+ * Size of the blocks of slots of the pools
+ */
+#define LIST_POOL_BLOCK_SIZE (4096)
+
+/**
+ * Number of elements released at once by the reclaim thread
+ */
+#define LIST_RECLAIM_BATCH (1024)
+
+/**
+ * Operation adding an element at a position of the list
+ */
+#define LIST_ADD_OP(position) ((LIST_POSITION_HEAD == (position)) ? LIST_OP_ADD_HEAD : ((LIST_POSITION_TAIL == (position)) ? LIST_OP_ADD_TAIL : LIST_OP_ADD))
+
+/**
+ * Position of an element added to the list
+ */
+typedef enum {
+    LIST_POSITION_SORTED, /**< Element is added using the sort callback, at the tail of the list if not used */
+    LIST_POSITION_HEAD,   /**< Element is added to the head of the list */
+    LIST_POSITION_TAIL    /**< Element is added to the tail of the list */
+} list_position_t;
+
+/**
+ * Node of the order statistic index, the index is a treap ordered by position of the elements in the list
+ */
+typedef struct list_rank_s {
+    struct list_rank_s *parent;   /**< Parent node */
+    struct list_rank_s *left;     /**< Left child node, elements before the element */
+    struct list_rank_s *right;    /**< Right child node, elements after the element */
+    size_t              size;     /**< Number of nodes of the subtree */
+    uint64_t            priority; /**< Priority of the node */
+    list_element_t *    element;  /**< List element */
+} list_rank_t;
+
+/**
+ * Copy of an element, stored after the list element when elements are allocated
+ */
+typedef struct {
+    size_t size;  /**< Size of the element */
+    bool   owned; /**< Flag to indicate if the element has been allocated by the caller */
+} list_copy_t;
+
+/**
+ * Free list element in a cache, batches of the global pool are linked using their first list element
+ */
+typedef struct list_cache_node_s {
+    struct list_cache_node_s *next;  /**< Next free list element of the batch */
+    struct list_cache_node_s *batch; /**< Next batch of the global pool */
+} list_cache_node_t;
+
+/**
+ * Per-thread cache of free list elements
+ */
+typedef struct {
+    list_cache_node_t *nodes; /**< Free list elements */
+    size_t             count; /**< Number of free list elements */
+} list_cache_t;
+
+/**
+ * Global pool of batches of free list elements
+ */
+typedef struct {
+    pthread_mutex_t    mutex;   /**< Mutex used to protect the access to the pool */
+    list_cache_node_t *batches; /**< Batches of free list elements */
+    size_t             count;   /**< Number of batches */
+} list_cache_pool_t;
+
+/**
+ * Free slot of a pool
+ */
+typedef struct list_slot_s {
+    struct list_slot_s *next; /**< Next free slot of the pool */
+} list_slot_t;
+
+/**
+ * Block of slots of a pool, slots are allocated just after the header
+ */
+typedef struct list_block_s {
+    struct list_block_s *next; /**< Next block of the pool */
+    size_t               size; /**< Size of the block */
+} list_block_t;
+
+/**
+ * Pool of slots used to copy the elements
+ */
+typedef struct {
+    size_t        size;   /**< Size of the slots */
+    list_slot_t * slots;  /**< Free slots */
+    list_block_t *blocks; /**< Blocks of slots */
+    size_t        held;   /**< Number of bytes of the blocks */
+    size_t        used;   /**< Number of slots currently used */
+} list_pool_t;
+
+/**
+ * Pools of slots of the list
+ */
+typedef struct list_pools_s {
+    pthread_mutex_t mutex;  /**< Mutex used to protect the access to the pools */
+    size_t          count;  /**< Number of pools */
+    list_pool_t     pool[]; /**< Pools, ordered by size of the slots */
+} list_pools_t;
+
+/**
+ * Header of a shared copy of an element, the element is copied just after the header
+ */
+typedef struct {
+    size_t           refs;      /**< Number of references to the element */
+    size_t           size;      /**< Size of the element */
+    list_allocator_t allocator; /**< Allocator used to allocate the element */
+} list_shared_t;
+
+/**
+ * Chunk of memory of the arena, memory is allocated just after the header
+ */
+typedef struct list_chunk_s {
+    struct list_chunk_s *next; /**< Next chunk of the arena */
+    size_t               size; /**< Size of the chunk */
+    size_t               used; /**< Size of the chunk already allocated */
+} list_chunk_t;
+
+/**
+ * Latency histogram, buckets are log-linear so that the relative precision is the same for all the values
+ */
+typedef struct {
+    uint64_t buckets[LIST_HISTOGRAM_BUCKETS]; /**< Number of samples per bucket */
+    uint64_t count;                           /**< Number of samples */
+    uint64_t max;                             /**< Maximum value recorded */
+} list_histogram_t;
+
+/******************************************************************************/
+/* Variables                                                                  */
+/******************************************************************************/
+
+/**
+ * Per-thread caches of free list elements
+ */
+static __thread list_cache_t list_cache[LIST_CACHE_CLASSES];
+
+/**
+ * Global pools of batches of free list elements
+ */
+static list_cache_pool_t list_cache_pool[LIST_CACHE_CLASSES];
+
+/**
+ * Key used to flush the per-thread caches when the thread exits
+ */
+static pthread_key_t  list_cache_key;
+static pthread_once_t list_cache_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Queue of the lists released asynchronously
+ */
+static pthread_mutex_t list_reclaim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  list_reclaim_cond  = PTHREAD_COND_INITIALIZER;
+static list_t *        list_reclaim_first = NULL;
+static list_t *        list_reclaim_last  = NULL;
+
+/**
+ * Reclaim thread
+ */
+static pthread_t list_reclaim_thread;
+static bool      list_reclaim_running = false;
+
+#ifdef LIST_USDT
+/**
+ * Semaphores of the tracing probes, incremented by the tracers attached to the probes
+ */
+unsigned short c_list_add_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+unsigned short c_list_remove_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+unsigned short c_list_get_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+unsigned short c_list_release_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+unsigned short c_list_lock_acquire_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+unsigned short c_list_lock_release_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+#endif
+
+#ifdef LIST_HISTOGRAMS
+/**
+ * Lock latency histograms per operation, time spent waiting for the semaphore and time the semaphore is held
+ */
+static list_histogram_t list_latency_wait[LIST_OP_COUNT];
+static list_histogram_t list_latency_hold[LIST_OP_COUNT];
+
+/**
+ * Names of the operations
+ */
+static const char *list_op_names[LIST_OP_COUNT] = {
+    "list_add",
+    "list_add_head",
+    "list_add_tail",
+    "list_add_at",
+    "alloc",
+    "list_set_expiry",
+    "list_expire",
+    "list_update_handle",
+    "list_remove_handle",
+    "list_move_head",
+    "list_move_tail",
+    "list_get_count",
+    "list_get_head",
+    "list_get_tail",
+    "list_get_next",
+    "list_get_prev",
+    "list_get_at",
+    "list_get_index",
+    "list_remove",
+    "list_remove_head",
+    "list_remove_tail",
+    "list_remove_at",
+    "list_memory_stats",
+    "list_trim",
+    "list_clear",
+    "list_reset",
+    "list_release",
+    "list_release_async",
+    "list_free_element",
+    "list_add_before",
+    "list_move_before",
+};
+#endif
+
 /******************************************************************************/
 /* Prototypes                                                                 */
 /******************************************************************************/
 
 /**
- * @brief Create a list element
+ * @brief Lock the list
+ * @param list List instance
+ * @param op Operation locking the list
+ */
+static inline void list_lock(list_t *list, list_op_t op);
+
+/**
+ * @brief Unlock the list
+ * @param list List instance
+ */
+static inline void list_unlock(list_t *list);
+
+/**
+ * @brief Invoke the sort callback of the list
+ * @param list List instance
+ * @param e1 First element
+ * @param e2 Second element
+ * @return Value returned by the sort callback
+ */
+static inline bool list_sort_element(list_t *list, void *e1, void *e2);
+
+#if defined(LIST_STATS) || defined(LIST_HISTOGRAMS) || defined(LIST_USDT)
+/**
+ * @brief Get current time in nanoseconds using monotonic clock, used to measure lock latency
+ * @return Current time in nanoseconds
+ */
+static uint64_t list_clock_ns(void);
+#endif
+
+#ifdef LIST_HISTOGRAMS
+/**
+ * @brief Record a sample in a latency histogram
+ * @param histogram Latency histogram
+ * @param value Sample in nanoseconds
+ */
+static void list_histogram_record(list_histogram_t *histogram, uint64_t value);
+
+/**
+ * @brief Compute latency percentiles of a histogram
+ * @param histogram Latency histogram
+ * @param latency Latency percentiles
+ */
+static void list_histogram_percentiles(list_histogram_t *histogram, list_latency_t *latency);
+
+/**
+ * @brief Get the highest value of a bucket of a latency histogram
+ * @param index Index of the bucket
+ * @return Highest value of the bucket in nanoseconds
+ */
+static uint64_t list_histogram_value(size_t index);
+#endif
+
+/**
+ * @brief Create a list element and add it to the list
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param position Position of the element in the list
+ * @return List element if the function succeeded, NULL otherwise
+ */
+static list_element_t *list_add_element(list_t *list, void *e, size_t size, list_position_t position);
+
+/**
+ * @brief Add a list element to the list, the list must be locked by list_create_locked and is unlocked, the list element is released if an error occurred
+ * @param list List instance
+ * @param list_element List element
+ * @param position Position of the element in the list
+ * @param start Time at which the operation started, used by the tracing probes
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int list_add_node(list_t *list, list_element_t *list_element, list_position_t position, uint64_t start);
+
+/**
+ * @brief Add element allocated by the caller to the list without copying it
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param position Position of the element in the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int list_add_owned_element(list_t *list, void *e, size_t size, list_position_t position);
+
+/**
+ * @brief Allocate a list element, the list must be locked if list elements are allocated in the arena
+ * @param list List instance
+ * @param size Size of the element copied just after the list element, arena only
+ * @param locked true if the list is locked, list elements kept for future allocations are used only if the list is locked
+ * @return List element if the function succeeded, NULL otherwise
+ */
+static list_element_t *list_alloc_node(list_t *list, size_t size, bool locked);
+
+/**
+ * @brief Create a list element and lock the list, list elements of the arena or kept for future allocations are allocated once the list is locked so that adding an element locks the list once
+ * @param list List instance
+ * @param e Element to be added in the list, NULL to allocate the list element only
+ * @param size Size of the element to be added
+ * @param op Operation locking the list
+ * @return List element if the function succeeded and the list is locked, NULL otherwise and the list is not locked
+ */
+static list_element_t *list_create_locked(list_t *list, void *e, size_t size, list_op_t op);
+
+/**
+ * @brief Create a list element, the list must be locked if list elements are allocated in the arena
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param locked true if the list is locked
+ * @return List element if the function succeeded, NULL otherwise
+ */
+static list_element_t *list_create_element(list_t *list, void *e, size_t size, bool locked);
+
+/**
+ * @brief Release a list element and the element itself if it has been allocated
+ * @param list List instance
+ * @param list_element List element
+ */
+static void list_release_element(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Release a list element without the element itself
+ * @param list List instance
+ * @param list_element List element
+ */
+static void list_release_node(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Release the element itself if it has been allocated
+ * @param list List instance
+ * @param list_element List element
+ */
+static void list_release_copy(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Release list elements from the head of the list, the list must be locked and is no longer usable until it is reset
+ * @param list List instance
+ * @param budget Maximum number of elements released, 0 to release all the elements
+ * @param keep true to keep the list elements and the current chunk of the arena for future allocations
+ * @return Number of elements released
+ */
+static size_t list_release_elements(list_t *list, size_t budget, bool keep);
+
+/**
+ * @brief Reset the list once the elements have been released, the list must be locked
+ * @param list List instance
+ */
+static void list_reset_elements(list_t *list);
+
+/**
+ * @brief Release memory kept by the list for future allocations, the list must be locked
+ * @param list List instance
+ * @return Number of bytes released
+ */
+static size_t list_release_cached(list_t *list);
+
+/**
+ * @brief Release list instance once the elements have been released
+ * @param list List instance
+ */
+static void list_destroy(list_t *list);
+
+/**
+ * @brief Reclaim thread releasing elements of the lists released asynchronously
+ * @param arg Unused
+ * @return Unused
+ */
+static void *list_reclaim_handler(void *arg);
+
+/**
+ * @brief Link a list element in the list, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @param position Position of the element in the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int list_link_element(list_t *list, list_element_t *list_element, list_position_t position);
+
+/**
+ * @brief Link a list element in the list just before another list element, the list must be locked, not available in heap mode
+ * @param list List instance
+ * @param list_element List element
+ * @param next List element before which the list element is added, NULL to add it at the end of the list
+ */
+static void list_link_element_before(list_t *list, list_element_t *list_element, list_element_t *next);
+
+/**
+ * @brief Unlink a list element from the list, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ */
+static void list_unlink_element(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Get the list element at the wanted position, the list must be locked
+ * @param list List instance
+ * @param index Position of the list element
+ * @return List element, NULL if the position is out of the list
+ */
+static list_element_t *list_get_element_at(list_t *list, size_t index);
+
+/**
+ * @brief Get the list element following a list element, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @return Next list element, NULL if the end of the list is reached
+ */
+static list_element_t *list_get_next_element(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Get the list element preceding a list element, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @return Previous list element, NULL if the beginning of the list is reached
+ */
+static list_element_t *list_get_prev_element(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Remove expired list elements starting from a list element, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @param forward true to parse the list forward, false to parse it backward
+ * @return First list element which is not expired, NULL if the end of the list is reached
+ */
+static list_element_t *list_skip_expired(list_t *list, list_element_t *list_element, bool forward);
+
+/**
+ * @brief Get current time in milliseconds using monotonic clock
+ * @return Current time in milliseconds
+ */
+static uint64_t list_clock_monotonic(void);
+
+/**
+ * @brief Push a list element in the heap
+ * @param list List instance
+ * @param list_element List element
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int list_heap_push(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Remove a list element from the heap
+ * @param list List instance
+ * @param list_element List element
+ */
+static void list_heap_remove(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Move a list element up in the heap until heap ordering is restored
+ * @param list List instance
+ * @param pos Position of the list element in the heap
+ * @return New position of the list element in the heap
+ */
+static size_t list_heap_sift_up(list_t *list, size_t pos);
+
+/**
+ * @brief Move a list element down in the heap until heap ordering is restored
+ * @param list List instance
+ * @param pos Position of the list element in the heap
+ */
+static void list_heap_sift_down(list_t *list, size_t pos);
+
+/**
+ * @brief Update first and last elements of the list from the heap
+ * @param list List instance
+ */
+static void list_heap_update_bounds(list_t *list);
+
+/**
+ * @brief Add a node to the order statistic index just before another node
+ * @param list List instance
+ * @param rank Node to be added
+ * @param next Node before which the node is added, NULL to add it at the end
+ */
+static void list_rank_insert(list_t *list, list_rank_t *rank, list_rank_t *next);
+
+/**
+ * @brief Remove a node from the order statistic index
+ * @param list List instance
+ * @param rank Node to be removed
+ */
+static void list_rank_remove(list_t *list, list_rank_t *rank);
+
+/**
+ * @brief Rotate a node of the order statistic index above its parent
+ * @param list List instance
+ * @param rank Node to be rotated
+ */
+static void list_rank_rotate(list_t *list, list_rank_t *rank);
+
+/**
+ * @brief Get number of nodes of a subtree of the order statistic index
+ * @param rank Root node of the subtree, NULL if the subtree is empty
+ * @return Number of nodes of the subtree
+ */
+static size_t list_rank_size(list_rank_t *rank);
+
+/**
+ * @brief Allocate memory in the arena, the list must be locked
+ * @param list List instance
+ * @param size Size of the memory
+ * @return Allocated memory, NULL if an error occurred
+ */
+static void *list_arena_alloc(list_t *list, size_t size);
+
+/**
+ * @brief Release chunks of memory of the arena, the list must be locked
+ * @param list List instance
+ * @param keep true to keep the current chunk for future allocations
+ */
+static void list_arena_release(list_t *list, bool keep);
+
+/**
+ * @brief Allocate memory using the allocator of the list
+ * @param list List instance
+ * @param size Size of the memory
+ * @return Allocated memory, NULL if an error occurred
+ */
+static void *list_alloc_memory(list_t *list, size_t size);
+
+/**
+ * @brief Release memory using the allocator of the list
+ * @param list List instance
+ * @param ptr Memory to be released
+ * @param size Size of the memory
+ */
+static void list_free_memory(list_t *list, void *ptr, size_t size);
+
+/**
+ * @brief Allocate memory to copy an element, using the pools of the list if possible
+ * @param list List instance
+ * @param size Size of the element
+ * @return Allocated memory, NULL if an error occurred
+ */
+static void *list_alloc_payload(list_t *list, size_t size);
+
+/**
+ * @brief Release memory of the copy of an element, using the pools of the list if possible
+ * @param list List instance
+ * @param ptr Memory to be released
+ * @param size Size of the element
+ */
+static void list_free_payload(list_t *list, void *ptr, size_t size);
+
+/**
+ * @brief Get the pool used to copy an element
+ * @param list List instance
+ * @param size Size of the element
+ * @return Pool, NULL if the element is too large or if pools are not used
+ */
+static list_pool_t *list_get_pool(list_t *list, size_t size);
+
+/**
+ * @brief Get header of a shared copy of an element
+ * @param e Element
+ * @return Header of the shared copy
+ */
+static list_shared_t *list_get_shared(void *e);
+
+/**
+ * @brief Check if the element is copied in the list element itself
+ * @param list List instance
+ * @param list_element List element
+ * @return true if the element is copied in the list element, false otherwise
+ */
+static bool list_is_inline(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Check if a list element must be kept when its element is returned to the caller, the list must be locked
+ * @param list List instance
+ * @param list_element List element, unlinked from the list
+ * @return true if the list element is kept until the element is released using list_free_element, false otherwise
+ */
+static bool list_keep_node(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Get expiry time of a list element
+ * @param list List instance
+ * @param list_element List element
+ * @return Expiry time of the list element, 0 if the element never expires or if the expiry time is not stored in the list elements
+ */
+static inline uint64_t list_get_expiry(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Get size of the copy of an element
+ * @param list List instance
+ * @param list_element List element
+ * @return Size of the copy of the element, 0 if elements are not allocated
+ */
+static inline size_t list_get_size(list_t *list, list_element_t *list_element);
+
+/**
+ * @brief Allocate a list element from the cache of the current thread
+ * @param size Size of the list element
+ * @return Allocated list element, NULL if an error occurred
+ */
+static void *list_cache_alloc(size_t size);
+
+/**
+ * @brief Release a list element to the cache of the current thread, a batch of list elements is returned to the global pool when the cache is full
+ * @param size Size of the list element
+ * @param ptr List element to be released
+ */
+static void list_cache_free(size_t size, void *ptr);
+
+/**
+ * @brief Create the global pools and the key used to flush the per-thread caches when the thread exits
+ */
+static void list_cache_init(void);
+
+/**
+ * @brief Flush the per-thread caches when the thread exits
+ * @param arg Unused
+ */
+static void list_cache_flush(void *arg);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Function used to create list instance
+ * @param alloc true if element should be allocated when they are added in the list, false for a copy only
+ * @param sort Callback function invoked to sort elements of the list, NULL if not used
+ * @return List instance if the function succeeded, NULL otherwise
+ */
+list_t *
+list_create(bool alloc, bool (*sort)(list_t *, void *, void *)) {
+
+    /* Create list instance with default options */
+    return list_create_ext(alloc, sort, NULL);
+}
+
+/**
+ * @brief Function used to create list instance with options
+ * @param alloc true if element should be allocated when they are added in the list, false for a copy only
+ * @param sort Callback function invoked to sort elements of the list, NULL if not used (mandatory in heap mode)
+ * @param options List options, NULL to use default options
+ * @return List instance if the function succeeded, NULL otherwise
+ */
+list_t *
+list_create_ext(bool alloc, bool (*sort)(list_t *, void *, void *), const list_options_t *options) {
+
+    /* Create list instance with default allocator */
+    return list_create_allocator(alloc, sort, options, NULL);
+}
+
+/**
+ * @brief Function used to create list instance with options and allocator
+ * @param alloc true if element should be allocated when they are added in the list, false for a copy only
+ * @param sort Callback function invoked to sort elements of the list, NULL if not used (mandatory in heap mode)
+ * @param options List options, NULL to use default options
+ * @param allocator Allocator used for the list elements and the copy of the elements, NULL to use malloc and free
+ * @return List instance if the function succeeded, NULL otherwise
+ */
+list_t *
+list_create_allocator(bool alloc, bool (*sort)(list_t *, void *, void *), const list_options_t *options, const list_allocator_t *allocator) {
+
+    /* Check allocator */
+    if ((NULL != allocator) && ((NULL == allocator->alloc) || (NULL == allocator->free))) {
+        /* Both callback functions are required */
+        return NULL;
+    }
+
+    /* Check options */
+    if ((NULL != options) && (LIST_MODE_HEAP == options->mode) && (NULL == sort)) {
+        /* Heap mode requires the sort callback */
+        return NULL;
+    }
+    if ((NULL != options) && (true == options->thread_cache) && ((true == options->arena) || (NULL != allocator))) {
+        /* Per-thread caches allocate list elements using malloc */
+        return NULL;
+    }
+    if ((NULL != options) && (NULL != options->pools) && (0 != options->npools) && (true == options->arena)) {
+        /* Copy of the elements are stored in the arena */
+        return NULL;
+    }
+    if ((NULL != options) && (LIST_INLINE_MAX < options->inline_size) && (true == options->thread_cache)) {
+        /* Classes of the per-thread caches are sized for the largest inline elements */
+        return NULL;
+    }
+    if ((NULL != options) && (0 != options->inline_size) && (true == options->arena)) {
+        /* Copy of the elements are already stored just after the list elements in the arena */
+        return NULL;
+    }
+    if ((NULL != options) && (true == options->shared) && ((0 != options->inline_size) || ((NULL != options->pools) && (0 != options->npools)))) {
+        /* Shared copy of the elements are allocated individually with their reference count */
+        return NULL;
+    }
+
+    /* Create list instance */
+    list_t *list = (list_t *)malloc(sizeof(list_t));
+    if (NULL == list) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+    memset(list, 0, sizeof(list_t));
+
+    /* Save alloc flag */
+    list->alloc = alloc;
+
+    /* Save sort callback */
+    list->sort = sort;
+
+    /* Save options, the order statistic index is not required in heap mode */
+    if (NULL != options) {
+        list->mode    = options->mode;
+        list->lock    = options->lock;
+        list->clock   = options->clock;
+        list->indexed = (LIST_MODE_LINKED == options->mode) && (true == options->indexed);
+        list->arena   = options->arena;
+    }
+    if (NULL == list->clock) {
+        list->clock = list_clock_monotonic;
+    }
+
+    /* Statistics and probes are updated by the functions of the library only, the inline accessors must not parse the list directly */
+#if defined(LIST_STATS) || defined(LIST_USDT)
+    list->instrumented = true;
+#endif
+
+    /* Save allocator */
+    if (NULL != allocator) {
+        list->allocator = *allocator;
+    }
+
+    /* Compute size of the list elements, only the fields required by the options are stored after the list element, the element itself is copied after them if small enough */
+    size_t offset = sizeof(list_element_t) + ((true == list->indexed) ? sizeof(list_rank_t) : 0);
+    if (LIST_MODE_HEAP == list->mode) {
+        list->pos_offset = offset;
+        offset += sizeof(size_t);
+    }
+    if ((NULL != options) && (true == options->ttl)) {
+        list->expiry_offset = offset;
+        offset += sizeof(uint64_t);
+    }
+    if (true == alloc) {
+        list->copy_offset = offset;
+        offset += sizeof(list_copy_t);
+    }
+    list->node_size = LIST_ARENA_ALIGN(offset);
+    if ((NULL != options) && (0 != options->inline_size) && (true == alloc)) {
+        list->inline_size = LIST_ARENA_ALIGN(options->inline_size);
+        list->node_size += list->inline_size;
+    }
+
+    /* Per-thread caches */
+    if ((NULL != options) && (true == options->thread_cache)) {
+        pthread_once(&list_cache_once, list_cache_init);
+        list->thread_cache = true;
+    }
+
+    /* Copy of the elements are shared between lists using a reference count, they are allocated individually */
+    if ((NULL != options) && (true == options->shared) && (true == alloc)) {
+        list->shared = true;
+    }
+
+    /* Create pools, ordered by size of the slots */
+    if ((NULL != options) && (NULL != options->pools) && (0 != options->npools) && (true == alloc)) {
+        list->pools = (list_pools_t *)list_alloc_memory(list, sizeof(list_pools_t) + options->npools * sizeof(list_pool_t));
+        if (NULL == list->pools) {
+            /* Unable to allocate memory */
+            free(list);
+            return NULL;
+        }
+        memset(list->pools, 0, sizeof(list_pools_t) + options->npools * sizeof(list_pool_t));
+        pthread_mutex_init(&list->pools->mutex, NULL);
+        for (size_t index = 0; index < options->npools; index++) {
+            size_t size = LIST_ARENA_ALIGN((sizeof(list_slot_t) > options->pools[index]) ? sizeof(list_slot_t) : options->pools[index]);
+            size_t pos  = list->pools->count;
+            while ((0 < pos) && (list->pools->pool[pos - 1].size > size)) {
+                list->pools->pool[pos] = list->pools->pool[pos - 1];
+                pos--;
+            }
+            list->pools->pool[pos].size = size;
+            list->pools->count++;
+        }
+    }
+
+    /* Initialize semaphore used to access the list */
+    sem_init(&list->sem, 0, 1);
+
+    return list;
+}
+
+/**
+ * @brief Add element to the the list
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Add element to the list */
+    return (NULL != list_add_element(list, e, size, LIST_POSITION_SORTED)) ? 0 : -1;
+}
+
+/**
+ * @brief Add element to the head of the list
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add_head(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Add element to the head of the list */
+    return (NULL != list_add_element(list, e, size, LIST_POSITION_HEAD)) ? 0 : -1;
+}
+
+/**
+ * @brief Add element to the tail of the list
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add_tail(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Add element to the tail of the list */
+    return (NULL != list_add_element(list, e, size, LIST_POSITION_TAIL)) ? 0 : -1;
+}
+
+/**
+ * @brief Add element allocated by the caller to the list without copying it, the list takes ownership of the element
+ * @param list List instance
+ * @param e Element to be added in the list, allocated using the allocator of the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add_owned(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Add element to the list */
+    return list_add_owned_element(list, e, size, LIST_POSITION_SORTED);
+}
+
+/**
+ * @brief Add element allocated by the caller to the tail of the list without copying it, the list takes ownership of the element
+ * @param list List instance
+ * @param e Element to be added in the list, allocated using the allocator of the list
+ * @param size Size of the element to be added
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add_tail_owned(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Add element to the list */
+    return list_add_owned_element(list, e, size, LIST_POSITION_TAIL);
+}
+
+/**
+ * @brief Add an element of another list to the list without copying it, both lists must share the copy of the elements
+ * @param list List instance
+ * @param e Element to be added in the list, the element is shared by the lists
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add_shared(list_t *list, void *e) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Check if the copy of the elements are shared */
+    if (false == list->shared) {
+        return -1;
+    }
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, NULL, 0, LIST_OP_ADD);
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return -1;
+    }
+
+    /* Reference the element */
+    list_shared_t *shared = list_get_shared(e);
+    __atomic_add_fetch(&shared->refs, 1, __ATOMIC_RELAXED);
+    list_element->e                     = e;
+    LIST_COPY(list, list_element)->size = shared->size;
+
+    /* Add element to the list */
+    return list_add_node(list, list_element, LIST_POSITION_SORTED, start);
+}
+
+/**
+ * @brief Add element to the list and return its handle
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @return Handle of the element if the function succeeded, NULL otherwise
+ */
+list_element_t *
+list_add_handle(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Add element to the list */
+    return list_add_element(list, e, size, LIST_POSITION_SORTED);
+}
+
+/**
+ * @brief Add element to the list with a time to live
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param ttl Time to live of the element, in the unit of the clock of the list
+ * @return 0 if the function succeeded, -1 otherwise, the list must be created with the ttl option
+ */
+int
+list_add_ttl(list_t *list, void *e, size_t size, uint64_t ttl) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* The expiry time must be stored in the list elements */
+    if (0 == list->expiry_offset) {
+        return -1;
+    }
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, e, size, LIST_OP_ADD);
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return -1;
+    }
+
+    /* Set expiry time of the element */
+    LIST_EXPIRY(list, list_element) = list->clock() + ttl;
+
+    /* Add element to the list */
+    return list_add_node(list, list_element, LIST_POSITION_SORTED, start);
+}
+
+/**
+ * @brief Set expiry time of an element of the list using its handle, nothing is done if the list is not created with the ttl option
+ * @param list List instance
+ * @param handle Handle of the element
+ * @param expiry Expiry time of the element, in the unit of the clock of the list, 0 if the element never expires
+ */
+void
+list_set_expiry(list_t *list, list_element_t *handle, uint64_t expiry) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    /* The expiry time must be stored in the list elements */
+    if (0 == list->expiry_offset) {
+        return;
+    }
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_SET_EXPIRY);
+
+    /* Update number of elements with an expiry time */
+    if ((0 == LIST_EXPIRY(list, handle)) && (0 != expiry)) {
+        list->expiring++;
+    } else if ((0 != LIST_EXPIRY(list, handle)) && (0 == expiry)) {
+        list->expiring--;
+    }
+
+    /* Set expiry time of the element */
+    LIST_EXPIRY(list, handle) = expiry;
+
+    /* Unlock the list */
+    list_unlock(list);
+}
+
+/**
+ * @brief Get current time of the clock of the list
+ * @param list List instance
+ * @return Current time of the clock of the list
+ */
+uint64_t
+list_get_time(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Invoke clock callback */
+    return list->clock();
+}
+
+/**
+ * @brief Remove expired elements of the list, checking a bounded number of elements from where the previous call stopped
+ * @param list List instance
+ * @param now Current time, in the unit of the clock of the list
+ * @param budget Maximum number of elements checked, 0 to check all the elements of the list
+ * @return Number of elements removed
+ */
+size_t
+list_expire(list_t *list, uint64_t now, size_t budget) {
+
+    assert(NULL != list);
+
+    size_t count = 0;
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_EXPIRE);
+
+    /* Check elements from where the previous call stopped, the lock is held for a bounded number of elements */
+    size_t          checked      = 0;
+    list_element_t *list_element = (NULL != list->sweep) ? list->sweep : list->first;
+    while ((0 < list->expiring) && (NULL != list_element) && ((0 == budget) || (checked < budget))) {
+        list_element_t *tmp = list_element;
+        list_element        = list_get_next_element(list, list_element);
+        if ((0 != LIST_EXPIRY(list, tmp)) && (LIST_EXPIRY(list, tmp) <= now)) {
+            list_unlink_element(list, tmp);
+            list_release_element(list, tmp);
+            count++;
+        }
+        checked++;
+    }
+
+    /* Save the next element to be checked, the next call restarts from the head of the list when the end is reached */
+    list->sweep = list_element;
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return count;
+}
+
+/**
+ * @brief Update position of an element of the list after its sort key has been modified
+ * @param list List instance
+ * @param handle Handle of the element
+ */
+void
+list_update_handle(list_t *list, list_element_t *handle) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_UPDATE_HANDLE);
+
+    /* Move the element to its new position */
+    if (LIST_MODE_HEAP == list->mode) {
+        list_heap_sift_down(list, list_heap_sift_up(list, LIST_POS(list, handle)));
+        list_heap_update_bounds(list);
+    } else if (NULL != list->sort) {
+        list_element_t *curr = list->curr;
+        list_unlink_element(list, handle);
+        list_link_element(list, handle, LIST_POSITION_SORTED);
+        if (handle == curr) {
+            list->curr = handle;
+        }
+    }
+
+    /* Unlock the list */
+    list_unlock(list);
+}
+
+/**
+ * @brief Remove element of the list using its handle
+ * @param list List instance
+ * @param handle Handle of the element
+ */
+void
+list_remove_handle(list_t *list, list_element_t *handle) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    uint64_t start = LIST_PROBE_START(remove);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_REMOVE_HANDLE);
+
+    /* Remove the element from the list */
+    list_unlink_element(list, handle);
+
+    LIST_PROBE_END(remove, list, list->count, LIST_OP_REMOVE_HANDLE, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    /* Release memory */
+    list_release_element(list, handle);
+}
+
+/**
+ * @brief Add element to the list at the wanted position, not available in heap mode
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param index Position of the element in the list, from 0 to the number of elements of the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_add_at(list_t *list, void *e, size_t size, size_t index) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Elements of the heap are always ordered using the sort callback */
+    if (LIST_MODE_HEAP == list->mode) {
+        return -1;
+    }
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, e, size, LIST_OP_ADD_AT);
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return -1;
+    }
+
+    /* Check position */
+    if (index > list->count) {
+        /* Position is out of the list */
+        list_unlock(list);
+        list_release_element(list, list_element);
+        return -1;
+    }
+
+    /* Add element to the list just before the element currently at the wanted position */
+    list_link_element_before(list, list_element, list_get_element_at(list, index));
+
+    LIST_PROBE_END(add, list, list->count, LIST_OP_ADD_AT, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return 0;
+}
+
+/**
+ * @brief Add element to the list just before another element using its handle and return the handle of the new element, not available in heap mode
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param next Handle of the element before which the element is added, NULL to add the element to the tail of the list
+ * @return Handle of the element if the function succeeded, NULL otherwise
+ */
+list_element_t *
+list_add_before(list_t *list, void *e, size_t size, list_element_t *next) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Elements of the heap are always ordered using the sort callback */
+    if (LIST_MODE_HEAP == list->mode) {
+        return NULL;
+    }
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, e, size, LIST_OP_ADD_BEFORE);
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return NULL;
+    }
+
+    /* Add element to the list just before the next element */
+    list_link_element_before(list, list_element, next);
+
+    LIST_PROBE_END(add, list, list->count, LIST_OP_ADD_BEFORE, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return list_element;
+}
+
+/**
+ * @brief Add an element stored in the list element itself just before another element using its handle and return the handle of the new element, the element is not initialized, not available in heap mode
+ * @param list List instance, created with alloc true and an inline_size option of at least size
+ * @param size Size of the element to be added
+ * @param next Handle of the element before which the element is added, NULL to add the element to the tail of the list
+ * @return Handle of the element if the function succeeded, the e field of the handle is the storage of the element, NULL otherwise
+ */
+list_element_t *
+list_emplace_before(list_t *list, size_t size, list_element_t *next) {
+
+    assert(NULL != list);
+
+    /* Elements of the heap are always ordered using the sort callback, other elements must fit in the list element */
+    if ((LIST_MODE_HEAP == list->mode) || (false == list->alloc) || (size > list->inline_size)) {
+        return NULL;
+    }
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, NULL, 0, LIST_OP_ADD_BEFORE);
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return NULL;
+    }
+
+    /* Reserve the storage of the element just after the list element */
+    list_element->e                     = (unsigned char *)list_element + (list->node_size - list->inline_size);
+    LIST_COPY(list, list_element)->size = size;
+
+    /* Add element to the list just before the next element */
+    list_link_element_before(list, list_element, next);
+
+    LIST_PROBE_END(add, list, list->count, LIST_OP_ADD_BEFORE, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return list_element;
+}
+
+/**
+ * @brief Move element of the list to the head of the list using its handle, not available in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_move_head(list_t *list, list_element_t *handle) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    /* Elements of the heap can not be moved */
+    if (LIST_MODE_HEAP == list->mode) {
+        return -1;
+    }
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_MOVE_HEAD);
+
+    /* Move the element to the head of the list */
+    if (handle != list->first) {
+        list_element_t *curr = list->curr;
+        list_unlink_element(list, handle);
+        list_link_element(list, handle, LIST_POSITION_HEAD);
+        if (handle == curr) {
+            list->curr = handle;
+        }
+    }
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return 0;
+}
+
+/**
+ * @brief Move element of the list to the tail of the list using its handle, not available in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_move_tail(list_t *list, list_element_t *handle) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    /* Elements of the heap can not be moved */
+    if (LIST_MODE_HEAP == list->mode) {
+        return -1;
+    }
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_MOVE_TAIL);
+
+    /* Move the element to the tail of the list */
+    if (handle != list->last) {
+        list_element_t *curr = list->curr;
+        list_unlink_element(list, handle);
+        list_link_element(list, handle, LIST_POSITION_TAIL);
+        if (handle == curr) {
+            list->curr = handle;
+        }
+    }
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return 0;
+}
+
+/**
+ * @brief Move element of the list just before another element using their handles, not available in heap mode
+ * @param list List instance
+ * @param handle Handle of the element
+ * @param next Handle of the element before which the element is moved, NULL to move the element to the tail of the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_move_before(list_t *list, list_element_t *handle, list_element_t *next) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    /* Elements of the heap can not be moved */
+    if (LIST_MODE_HEAP == list->mode) {
+        return -1;
+    }
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_MOVE_BEFORE);
+
+    /* Move the element just before the next element */
+    if ((handle != next) && (handle->next != next)) {
+        list_element_t *curr = list->curr;
+        list_unlink_element(list, handle);
+        list_link_element_before(list, handle, next);
+        if (handle == curr) {
+            list->curr = handle;
+        }
+    }
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return 0;
+}
+
+/**
+ * @brief Get number of element in the list
+ * @param list List instance
+ * @return Number of elements in the list
+ */
+size_t
+list_get_count(list_t *list) {
+
+    assert(NULL != list);
+
+    size_t count = 0;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_COUNT);
+
+    /* Get number of elements */
+    count = list->count;
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_COUNT, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return count;
+}
+
+/**
+ * @brief Get head element of the list
+ * @param list List instance
+ * @return Head element of the list, NULL if the list is empty
+ */
+void *
+list_get_head(list_t *list) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_HEAD);
+
+    /* Get head list element */
+    list->curr = list_skip_expired(list, list->first, true);
+
+    /* Get element */
+    if (NULL != list->curr) {
+        e = list->curr->e;
+        LIST_STATS_ADD(list, traversal_steps, 1);
+    }
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_HEAD, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return e;
+}
+
+/**
+ * @brief Get tail element of the list
+ * @param list List instance
+ * @return Tail element of the list, NULL if the list is empty
+ */
+void *
+list_get_tail(list_t *list) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_TAIL);
+
+    /* Get last list element */
+    list->curr = list_skip_expired(list, list->last, false);
+
+    /* Get element */
+    if (NULL != list->curr) {
+        e = list->curr->e;
+        LIST_STATS_ADD(list, traversal_steps, 1);
+    }
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_TAIL, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return e;
+}
+
+/**
+ * @brief Get next element of the list
+ * @param list List instance
+ * @return Next element of the list, NULL if the end of the list is reached
+ */
+void *
+list_get_next(list_t *list) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_NEXT);
+
+    /* Get next list element */
+    if (NULL != list->curr) {
+        list->curr = list_skip_expired(list, list_get_next_element(list, list->curr), true);
+    }
+
+    /* Get element */
+    if (NULL != list->curr) {
+        e = list->curr->e;
+        LIST_STATS_ADD(list, traversal_steps, 1);
+    }
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_NEXT, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return e;
+}
+
+/**
+ * @brief Get previous element of the list
+ * @param list List instance
+ * @return Previous element of the list, NULL if the beginning of the list is reached
+ */
+void *
+list_get_prev(list_t *list) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_PREV);
+
+    /* Get previous list element */
+    if (NULL != list->curr) {
+        list->curr = list_skip_expired(list, list_get_prev_element(list, list->curr), false);
+    }
+
+    /* Get element */
+    if (NULL != list->curr) {
+        e = list->curr->e;
+        LIST_STATS_ADD(list, traversal_steps, 1);
+    }
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_PREV, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return e;
+}
+
+/**
+ * @brief Get element of the list at the wanted position, the element becomes the current element of the list
+ * @param list List instance
+ * @param index Position of the element in the list
+ * @return Element of the list, NULL if the position is out of the list
+ */
+void *
+list_get_at(list_t *list, size_t index) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_AT);
+
+    /* Get list element at the wanted position */
+    list_element_t *list_element = list_get_element_at(list, index);
+    if (NULL != list_element) {
+        list->curr = list_element;
+        e          = list_element->e;
+    }
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_AT, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return e;
+}
+
+/**
+ * @brief Get position of an element of the list using its handle
+ * @param list List instance
+ * @param handle Handle of the element
+ * @return Position of the element in the list
+ */
+size_t
+list_get_index(list_t *list, list_element_t *handle) {
+
+    assert(NULL != list);
+    assert(NULL != handle);
+
+    size_t index = 0;
+
+    uint64_t start = LIST_PROBE_START(get);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_GET_INDEX);
+
+    /* Compute position of the element */
+    if (LIST_MODE_HEAP == list->mode) {
+        index = LIST_POS(list, handle);
+    } else if (true == list->indexed) {
+        list_rank_t *rank = LIST_RANK(handle);
+        index             = list_rank_size(rank->left);
+        while (NULL != rank->parent) {
+            if (rank == rank->parent->right) {
+                index += list_rank_size(rank->parent->left) + 1;
+            }
+            rank = rank->parent;
+        }
+    } else {
+        for (list_element_t *tmp = list->first; handle != tmp; tmp = tmp->next) {
+            index++;
+        }
+    }
+
+    LIST_PROBE_END(get, list, list->count, LIST_OP_GET_INDEX, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return index;
+}
+
+/**
+ * @brief Remove element of the list
+ * @param list List instance
+ * @return Next element of the list, NULL if the element was tail element of the list
+ */
+void *
+list_remove(list_t *list, void *e) {
+
+    assert(NULL != list);
+
+    void *ret = NULL;
+
+    uint64_t start = LIST_PROBE_START(remove);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_REMOVE);
+
+    /* Search for the list element in the list */
+    list_element_t *tmp = list->first;
+    LIST_STATS_ADD(list, remove_scans, 1);
+    while ((NULL != tmp) && (tmp->e != e)) {
+        tmp = list_get_next_element(list, tmp);
+        LIST_STATS_ADD(list, remove_scan_steps, 1);
+    }
+    if (NULL == tmp) {
+        /* The element is not part of the list */
+        list_unlock(list);
+        return NULL;
+    }
+
+    /* Set next element */
+    ret = list_get_next_element(list, tmp);
+
+    /* Update the list */
+    list_unlink_element(list, tmp);
+
+    LIST_PROBE_END(remove, list, list->count, LIST_OP_REMOVE, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    /* Release memory */
+    list_release_element(list, tmp);
+
+    return ret;
+}
+
+/**
+ * @brief Remove head element of the list
+ * @param list List instance
+ * @return Head element of the list, NULL if the list is empty
+ */
+void *
+list_remove_head(list_t *list) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(remove);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_REMOVE_HEAD);
+
+    /* Update the list */
+    bool            kept = false;
+    list_element_t *tmp  = list_skip_expired(list, list->first, true);
+    if (NULL != tmp) {
+
+        /* Update current element if required */
+        if (tmp == list->curr) {
+            list->curr = list_get_next_element(list, tmp);
+        }
+
+        /* Get head element */
+        e = tmp->e;
+        list_unlink_element(list, tmp);
+        kept = list_keep_node(list, tmp);
+    }
+
+    LIST_PROBE_END(remove, list, list->count, LIST_OP_REMOVE_HEAD, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    /* Release memory, the list element is kept if the element is copied in it or allocated by the caller */
+    if ((NULL != tmp) && (false == kept)) {
+        list_release_node(list, tmp);
+    }
+
+    return e;
+}
+
+/**
+ * @brief Remove tail element of the list
+ * @param list List instance
+ * @return Tail element of the list, NULL if the list is empty
+ */
+void *
+list_remove_tail(list_t *list) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(remove);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_REMOVE_TAIL);
+
+    /* Update the list */
+    bool            kept = false;
+    list_element_t *tmp  = list_skip_expired(list, list->last, false);
+    if (NULL != tmp) {
+
+        /* Get tail element */
+        e = tmp->e;
+        list_unlink_element(list, tmp);
+        kept = list_keep_node(list, tmp);
+    }
+
+    LIST_PROBE_END(remove, list, list->count, LIST_OP_REMOVE_TAIL, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    /* Release memory, the list element is kept if the element is copied in it or allocated by the caller */
+    if ((NULL != tmp) && (false == kept)) {
+        list_release_node(list, tmp);
+    }
+
+    return e;
+}
+
+/**
+ * @brief Remove element of the list at the wanted position
+ * @param list List instance
+ * @param index Position of the element in the list
+ * @return Element of the list, NULL if the position is out of the list
+ */
+void *
+list_remove_at(list_t *list, size_t index) {
+
+    assert(NULL != list);
+
+    void *e = NULL;
+
+    uint64_t start = LIST_PROBE_START(remove);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_REMOVE_AT);
+
+    /* Update the list */
+    bool            kept = false;
+    list_element_t *tmp  = list_get_element_at(list, index);
+    if (NULL != tmp) {
+
+        /* Get element */
+        e = tmp->e;
+        list_unlink_element(list, tmp);
+        kept = list_keep_node(list, tmp);
+    }
+
+    LIST_PROBE_END(remove, list, list->count, LIST_OP_REMOVE_AT, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    /* Release memory, the list element is kept if the element is copied in it or allocated by the caller */
+    if ((NULL != tmp) && (false == kept)) {
+        list_release_node(list, tmp);
+    }
+
+    return e;
+}
+
+/**
+ * @brief Release an element returned by list_remove_head, list_remove_tail or list_remove_at when elements are allocated
+ * @param list List instance
+ * @param e Element to be released, elements added using list_add_owned or list_add_tail_owned are released using the allocator of the list and their own size
+ * @param size Size of the element, not used for elements allocated by the caller
+ */
+void
+list_free_element(list_t *list, void *e, size_t size) {
+
+    assert(NULL != list);
+
+    /* Elements are released by the caller if they are not allocated, memory of the arena is released with the list */
+    if ((NULL == e) || (false == list->alloc) || ((true == list->arena) && (false == list->shared))) {
+        return;
+    }
+
+    /* Search the list element kept when the element has been removed if it has been allocated by the caller */
+    list_element_t *list_element = NULL;
+    if (NULL != __atomic_load_n(&list->detached, __ATOMIC_RELAXED)) {
+        list_lock(list, LIST_OP_FREE_ELEMENT);
+        list_element_t **tmp = &list->detached;
+        while ((NULL != *tmp) && (e != (*tmp)->e)) {
+            tmp = &(*tmp)->next;
+        }
+        if (NULL != (list_element = *tmp)) {
+            __atomic_store_n(tmp, list_element->next, __ATOMIC_RELAXED);
+        }
+        list_unlock(list);
+    }
+
+    /* Release memory */
+    if (NULL != list_element) {
+        /* The element has been allocated by the caller, it is released using the allocator of the list and its own size */
+        list_free_memory(list, e, LIST_COPY(list, list_element)->size);
+        list_release_node(list, list_element);
+    } else if ((0 < list->inline_size) && (size <= list->inline_size)) {
+        /* The element is copied in the list element, which has not been released */
+        list_release_node(list, (list_element_t *)((unsigned char *)e - (list->node_size - list->inline_size)));
+    } else {
+        list_free_payload(list, e, size);
+    }
+}
+
+/**
+ * @brief Get usage of the pools of slots used to copy the elements
+ * @param list List instance
+ * @param usage Array filled with the usage of the pools
+ * @param count Size of the array
+ * @return Number of pools of the list
+ */
+size_t
+list_get_pool_usage(list_t *list, list_pool_usage_t *usage, size_t count) {
+
+    assert(NULL != list);
+    assert((NULL != usage) || (0 == count));
+
+    /* Check if pools are used */
+    if (NULL == list->pools) {
+        return 0;
+    }
+
+    /* Lock the pools */
+    if (LIST_LOCK_NONE != list->lock) {
+        pthread_mutex_lock(&list->pools->mutex);
+    }
+
+    /* Fill usage of the pools */
+    for (size_t index = 0; (index < list->pools->count) && (index < count); index++) {
+        list_pool_t *pool  = &list->pools->pool[index];
+        usage[index].size  = pool->size;
+        usage[index].held  = pool->held;
+        usage[index].used  = pool->used * pool->size;
+        usage[index].slots = pool->used;
+    }
+
+    /* Unlock the pools */
+    if (LIST_LOCK_NONE != list->lock) {
+        pthread_mutex_unlock(&list->pools->mutex);
+    }
+
+    return list->pools->count;
+}
+
+/**
+ * @brief Get memory usage of the list
+ * @param list List instance
+ * @param stats Memory usage of the list
+ */
+void
+list_memory_stats(list_t *list, list_memory_stats_t *stats) {
+
+    assert(NULL != list);
+    assert(NULL != stats);
+
+    memset(stats, 0, sizeof(list_memory_stats_t));
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_MEMORY_STATS);
+
+    /* Elements and list elements */
+    stats->count          = list->count;
+    stats->node_bytes     = list->count * list->node_size;
+    stats->payload_bytes  = list->bytes;
+    stats->cached_bytes   = list->cached * list->node_size;
+    stats->overhead_bytes = sizeof(list_t) + list->capacity * sizeof(list_element_t *);
+
+    /* Chunks of the arena */
+    for (list_chunk_t *chunk = list->chunks; NULL != chunk; chunk = chunk->next) {
+        stats->arena_bytes += LIST_ARENA_ALIGN(sizeof(list_chunk_t)) + chunk->size;
+    }
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    /* Blocks of the pools */
+    if (NULL != list->pools) {
+        if (LIST_LOCK_NONE != list->lock) {
+            pthread_mutex_lock(&list->pools->mutex);
+        }
+        stats->overhead_bytes += sizeof(list_pools_t) + list->pools->count * sizeof(list_pool_t);
+        for (size_t index = 0; index < list->pools->count; index++) {
+            list_pool_t *pool = &list->pools->pool[index];
+            stats->pool_bytes += pool->held;
+            for (list_block_t *block = pool->blocks; NULL != block; block = block->next) {
+                stats->cached_bytes += block->size - LIST_ARENA_ALIGN(sizeof(list_block_t));
+            }
+            stats->cached_bytes -= pool->used * pool->size;
+        }
+        if (LIST_LOCK_NONE != list->lock) {
+            pthread_mutex_unlock(&list->pools->mutex);
+        }
+    }
+}
+
+/**
+ * @brief Release memory kept by the list for future allocations
+ * @param list List instance
+ * @return Number of bytes released
+ */
+size_t
+list_trim(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_TRIM);
+
+    /* Release list elements kept by list_clear and blocks of the pools not used */
+    size_t bytes = list_release_cached(list);
+
+    /* Release the arena if the list is empty */
+    if ((0 == list->count) && (NULL != list->chunks)) {
+        for (list_chunk_t *chunk = list->chunks; NULL != chunk; chunk = chunk->next) {
+            bytes += LIST_ARENA_ALIGN(sizeof(list_chunk_t)) + chunk->size;
+        }
+        list_arena_release(list, false);
+    }
+
+    /* Shrink the heap array to the number of elements of the heap */
+    size_t capacity = (0 == list->count) ? 0 : ((LIST_HEAP_INITIAL_CAPACITY < list->count) ? list->count : LIST_HEAP_INITIAL_CAPACITY);
+    if (0 == capacity) {
+        bytes += list->capacity * sizeof(list_element_t *);
+        free(list->heap);
+        list->heap     = NULL;
+        list->capacity = 0;
+    } else if (capacity < list->capacity) {
+        list_element_t **heap = (list_element_t **)realloc(list->heap, capacity * sizeof(list_element_t *));
+        if (NULL != heap) {
+            bytes += (list->capacity - capacity) * sizeof(list_element_t *);
+            list->heap     = heap;
+            list->capacity = capacity;
+        }
+    }
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return bytes;
+}
+
+/**
+ * @brief Get operation and contention statistics of the list
+ * @param list List instance
+ * @param stats Statistics of the list, set to zero if statistics are not available
+ * @return 0 if the function succeeded, -1 if the library is built without LIST_STATS
+ */
+int
+list_get_stats(list_t *list, list_stats_t *stats) {
+
+    assert(NULL != list);
+    assert(NULL != stats);
+
+#ifdef LIST_STATS
+    /* Read counters, they are updated with relaxed atomic operations and may be read without locking the list */
+    stats->adds              = __atomic_load_n(&list->stats.adds, __ATOMIC_RELAXED);
+    stats->removes           = __atomic_load_n(&list->stats.removes, __ATOMIC_RELAXED);
+    stats->traversal_steps   = __atomic_load_n(&list->stats.traversal_steps, __ATOMIC_RELAXED);
+    stats->sort_calls        = __atomic_load_n(&list->stats.sort_calls, __ATOMIC_RELAXED);
+    stats->remove_scans      = __atomic_load_n(&list->stats.remove_scans, __ATOMIC_RELAXED);
+    stats->remove_scan_steps = __atomic_load_n(&list->stats.remove_scan_steps, __ATOMIC_RELAXED);
+    stats->lock_acquisitions = __atomic_load_n(&list->stats.lock_acquisitions, __ATOMIC_RELAXED);
+    stats->lock_contentions  = __atomic_load_n(&list->stats.lock_contentions, __ATOMIC_RELAXED);
+    stats->lock_wait_ns      = __atomic_load_n(&list->stats.lock_wait_ns, __ATOMIC_RELAXED);
+
+    return 0;
+#else
+    /* Statistics are not available */
+    memset(stats, 0, sizeof(list_stats_t));
+
+    return -1;
+#endif
+}
+
+/**
+ * @brief Reset operation and contention statistics of the list
+ * @param list List instance
+ */
+void
+list_reset_stats(list_t *list) {
+
+    assert(NULL != list);
+
+#ifdef LIST_STATS
+    /* Reset counters */
+    __atomic_store_n(&list->stats.adds, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.removes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.traversal_steps, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.sort_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.remove_scans, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.remove_scan_steps, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.lock_acquisitions, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.lock_contentions, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&list->stats.lock_wait_ns, 0, __ATOMIC_RELAXED);
+#endif
+}
+
+/**
+ * @brief Get lock latency percentiles of an operation, for all the lists
+ * @param op Operation
+ * @param wait Percentiles of the time spent waiting for the semaphore, set to zero if histograms are not available
+ * @param hold Percentiles of the time the semaphore is held, set to zero if histograms are not available
+ * @return 0 if the function succeeded, -1 if the library is built without LIST_HISTOGRAMS
+ */
+int
+list_get_latency(list_op_t op, list_latency_t *wait, list_latency_t *hold) {
+
+    assert(op < LIST_OP_COUNT);
+    assert(NULL != wait);
+    assert(NULL != hold);
+
+#ifdef LIST_HISTOGRAMS
+    /* Compute percentiles */
+    list_histogram_percentiles(&list_latency_wait[op], wait);
+    list_histogram_percentiles(&list_latency_hold[op], hold);
+
+    return 0;
+#else
+    /* Histograms are not available */
+    memset(wait, 0, sizeof(list_latency_t));
+    memset(hold, 0, sizeof(list_latency_t));
+
+    return -1;
+#endif
+}
+
+/**
+ * @brief Print lock latency percentiles of all the operations
+ * @param stream Output stream
+ */
+void
+list_dump_latency(FILE *stream) {
+
+    assert(NULL != stream);
+
+#ifdef LIST_HISTOGRAMS
+    /* Print percentiles of the operations which have been recorded */
+    fprintf(stream, "%-20s %-4s %12s %12s %12s %12s %12s %12s\n", "operation", "lock", "count", "p50_ns", "p90_ns", "p99_ns", "p999_ns", "max_ns");
+    for (size_t op = 0; op < LIST_OP_COUNT; op++) {
+        list_latency_t latency[2];
+        list_get_latency((list_op_t)op, &latency[0], &latency[1]);
+        for (size_t index = 0; index < 2; index++) {
+            if (0 != latency[index].count) {
+                fprintf(stream,
+                        "%-20s %-4s %12llu %12llu %12llu %12llu %12llu %12llu\n",
+                        list_op_names[op],
+                        (0 == index) ? "wait" : "hold",
+                        (unsigned long long)latency[index].count,
+                        (unsigned long long)latency[index].p50,
+                        (unsigned long long)latency[index].p90,
+                        (unsigned long long)latency[index].p99,
+                        (unsigned long long)latency[index].p999,
+                        (unsigned long long)latency[index].max);
+            }
+        }
+    }
+#else
+    fprintf(stream, "lock latency histograms are not available\n");
+#endif
+}
+
+/**
+ * @brief Reset lock latency histograms of all the operations
+ */
+void
+list_reset_latency(void) {
+
+#ifdef LIST_HISTOGRAMS
+    /* Reset histograms */
+    for (size_t op = 0; op < LIST_OP_COUNT; op++) {
+        list_histogram_t *histograms[2] = { &list_latency_wait[op], &list_latency_hold[op] };
+        for (size_t index = 0; index < 2; index++) {
+            for (size_t bucket = 0; bucket < LIST_HISTOGRAM_BUCKETS; bucket++) {
+                __atomic_store_n(&histograms[index]->buckets[bucket], 0, __ATOMIC_RELAXED);
+            }
+            __atomic_store_n(&histograms[index]->count, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&histograms[index]->max, 0, __ATOMIC_RELAXED);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Remove all elements of the list, memory of the list elements is kept for future allocations
+ * @param list List instance
+ */
+void
+list_clear(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_CLEAR);
+
+    /* Release list elements, list elements and the current chunk of the arena are kept for future allocations */
+    list_release_elements(list, 0, true);
+
+    /* Reset the list, the heap array is kept */
+    list_reset_elements(list);
+
+    /* Unlock the list */
+    list_unlock(list);
+}
+
+/**
+ * @brief Remove all elements of the list and release all the memory held by the list, options of the list are kept
+ * @param list List instance
+ */
+void
+list_reset(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Lock the list */
+    list_lock(list, LIST_OP_RESET);
+
+    /* Release list elements and memory kept for future allocations */
+    list_release_elements(list, 0, false);
+    list_release_cached(list);
+
+    /* Release heap */
+    free(list->heap);
+    list->heap     = NULL;
+    list->capacity = 0;
+
+    /* Reset the list */
+    list_reset_elements(list);
+
+    /* Unlock the list */
+    list_unlock(list);
+}
+
+/**
+ * @brief Release list instance
+ * @param list List instance
+ */
+void
+list_release(list_t *list) {
+
+    /* Release list instance */
+    if (NULL != list) {
+
+        uint64_t start = LIST_PROBE_START(release);
+        size_t   count = list->count;
+
+        /* Lock the list */
+        list_lock(list, LIST_OP_RELEASE);
+
+        /* Release list elements, all the memory of the arena is released at once */
+        list_release_elements(list, 0, false);
+
+        /* Unlock the list */
+        list_unlock(list);
+
+        /* Release list instance */
+        list_destroy(list);
+
+        LIST_PROBE_END(release, list, count, LIST_OP_RELEASE, start);
+    }
+}
+
+/**
+ * @brief Release list instance asynchronously, elements of the list are released by list_reclaim or by the reclaim thread
+ * @param list List instance
+ */
+void
+list_release_async(list_t *list) {
+
+    /* Release list instance */
+    if (NULL != list) {
+
+        /* Wait for pending accesses to the list */
+        list_lock(list, LIST_OP_RELEASE_ASYNC);
+        list_unlock(list);
+
+        /* Add the list to the queue of the lists released asynchronously */
+        pthread_mutex_lock(&list_reclaim_mutex);
+        list->reclaim = NULL;
+        if (NULL == list_reclaim_last) {
+            list_reclaim_first = list;
+        } else {
+            list_reclaim_last->reclaim = list;
+        }
+        list_reclaim_last = list;
+        pthread_cond_signal(&list_reclaim_cond);
+        pthread_mutex_unlock(&list_reclaim_mutex);
+    }
+}
+
+/**
+ * @brief Release elements of the lists released asynchronously
+ * @param budget Maximum number of elements released, 0 to release all the elements
+ * @return Number of elements released
+ */
+size_t
+list_reclaim(size_t budget) {
+
+    size_t count = 0;
+
+    /* Release lists of the queue until the budget is reached */
+    while ((0 == budget) || (count < budget)) {
+
+        /* Take the first list of the queue */
+        pthread_mutex_lock(&list_reclaim_mutex);
+        list_t *list = list_reclaim_first;
+        if (NULL != list) {
+            list_reclaim_first = list->reclaim;
+            if (NULL == list_reclaim_first) {
+                list_reclaim_last = NULL;
+            }
+        }
+        pthread_mutex_unlock(&list_reclaim_mutex);
+        if (NULL == list) {
+            break;
+        }
+
+        /* Release elements of the list, the list is no longer accessed by other threads */
+        count += list_release_elements(list, (0 == budget) ? 0 : budget - count, false);
+
+        /* Release the list once all its elements are released, otherwise put it back at the head of the queue */
+        if (0 == list->count) {
+            list_destroy(list);
+        } else {
+            pthread_mutex_lock(&list_reclaim_mutex);
+            list->reclaim      = list_reclaim_first;
+            list_reclaim_first = list;
+            if (NULL == list_reclaim_last) {
+                list_reclaim_last = list;
+            }
+            pthread_mutex_unlock(&list_reclaim_mutex);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Start the reclaim thread releasing elements of the lists released asynchronously
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_reclaim_start(void) {
+
+    int ret = 0;
+
+    /* Create the reclaim thread if it is not running */
+    pthread_mutex_lock(&list_reclaim_mutex);
+    if (false == list_reclaim_running) {
+        if (0 == pthread_create(&list_reclaim_thread, NULL, list_reclaim_handler, NULL)) {
+            list_reclaim_running = true;
+        } else {
+            /* Unable to create the thread */
+            ret = -1;
+        }
+    }
+    pthread_mutex_unlock(&list_reclaim_mutex);
+
+    return ret;
+}
+
+/**
+ * @brief Stop the reclaim thread, remaining elements of the lists released asynchronously are released before the thread exits
+ */
+void
+list_reclaim_stop(void) {
+
+    /* Request the reclaim thread to stop */
+    pthread_mutex_lock(&list_reclaim_mutex);
+    bool running         = list_reclaim_running;
+    list_reclaim_running = false;
+    pthread_cond_signal(&list_reclaim_cond);
+    pthread_mutex_unlock(&list_reclaim_mutex);
+
+    /* Wait for the reclaim thread */
+    if (true == running) {
+        pthread_join(list_reclaim_thread, NULL);
+    }
+}
+
+/**
+ * @brief Lock the list
+ * @param list List instance
+ * @param op Operation locking the list
+ */
+static inline void
+list_lock(list_t *list, list_op_t op) {
+
+    assert(NULL != list);
+    assert(op < LIST_OP_COUNT);
+
+    (void)op;
+
+    /* Wait semaphore, lock latency is measured when histograms are enabled or when a tracer is attached to the lock probes */
+    if (LIST_LOCK_SEMAPHORE == list->lock) {
+#if defined(LIST_HISTOGRAMS) || defined(LIST_USDT)
+        bool     timed = LIST_LOCK_TIMED();
+        uint64_t wait  = (true == timed) ? list_clock_ns() : 0;
+#endif
+#ifdef LIST_STATS
+        /* The time is measured only when the semaphore is not immediately available */
+        if (0 != sem_trywait(&list->sem)) {
+            uint64_t start = list_clock_ns();
+            sem_wait(&list->sem);
+            LIST_STATS_ADD(list, lock_wait_ns, list_clock_ns() - start);
+            LIST_STATS_ADD(list, lock_contentions, 1);
+        }
+        LIST_STATS_ADD(list, lock_acquisitions, 1);
+#else
+        sem_wait(&list->sem);
+#endif
+#if defined(LIST_HISTOGRAMS) || defined(LIST_USDT)
+        /* Record time spent waiting for the semaphore and save the time it is acquired */
+        list->hold_start = 0;
+        if (true == timed) {
+            list->hold_start = list_clock_ns();
+            list->hold_op    = op;
+#ifdef LIST_HISTOGRAMS
+            list_histogram_record(&list_latency_wait[op], list->hold_start - wait);
+#endif
+#ifdef LIST_USDT
+            STAP_PROBE3(c_list, lock_acquire, list, op, list->hold_start - wait);
+#endif
+        }
+#endif
+    }
+}
+
+/**
+ * @brief Unlock the list
+ * @param list List instance
+ */
+static inline void
+list_unlock(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Release semaphore */
+    if (LIST_LOCK_SEMAPHORE == list->lock) {
+#if defined(LIST_HISTOGRAMS) || defined(LIST_USDT)
+        /* Record time the semaphore has been held, if the time it has been acquired is known */
+        if (0 != list->hold_start) {
+            uint64_t hold = list_clock_ns() - list->hold_start;
+#ifdef LIST_HISTOGRAMS
+            list_histogram_record(&list_latency_hold[list->hold_op], hold);
+#endif
+#ifdef LIST_USDT
+            STAP_PROBE3(c_list, lock_release, list, list->hold_op, hold);
+#endif
+        }
+#endif
+        sem_post(&list->sem);
+    }
+}
+
+/**
+ * @brief Invoke the sort callback of the list
+ * @param list List instance
+ * @param e1 First element
+ * @param e2 Second element
+ * @return Value returned by the sort callback
+ */
+static inline bool
+list_sort_element(list_t *list, void *e1, void *e2) {
+
+    assert(NULL != list);
+    assert(NULL != list->sort);
+
+    LIST_STATS_ADD(list, sort_calls, 1);
+
+    return list->sort(list, e1, e2);
+}
+
+#if defined(LIST_STATS) || defined(LIST_HISTOGRAMS) || defined(LIST_USDT)
+/**
+ * @brief Get current time in nanoseconds using monotonic clock, used to measure lock latency
+ * @return Current time in nanoseconds
+ */
+static uint64_t
+list_clock_ns(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+/**
+ * @brief Create a list element and add it to the list
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param position Position of the element in the list
+ * @return List element if the function succeeded, NULL otherwise
+ */
+static list_element_t *
+list_add_element(list_t *list, void *e, size_t size, list_position_t position) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, e, size, LIST_ADD_OP(position));
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return NULL;
+    }
+
+    /* Add element to the list */
+    if (0 != list_add_node(list, list_element, position, start)) {
+        /* Unable to add element to the list */
+        return NULL;
+    }
+
+    return list_element;
+}
+
+/**
+ * @brief Add a list element to the list, the list must be locked by list_create_locked and is unlocked, the list element is released if an error occurred
+ * @param list List instance
+ * @param list_element List element
+ * @param position Position of the element in the list
+ * @param start Time at which the operation started, used by the tracing probes
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int
+list_add_node(list_t *list, list_element_t *list_element, list_position_t position, uint64_t start) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* The operation is identified using the position of the element */
+    list_op_t op = LIST_ADD_OP(position);
+
+    /* Add element to the list */
+    if (0 != list_link_element(list, list_element, position)) {
+        /* Unable to add element to the list */
+        list_unlock(list);
+        list_release_element(list, list_element);
+        return -1;
+    }
+
+    LIST_PROBE_END(add, list, list->count, op, start);
+
+    /* Unlock the list */
+    list_unlock(list);
+
+    return 0;
+}
+
+/**
+ * @brief Add element allocated by the caller to the list without copying it
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param position Position of the element in the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int
+list_add_owned_element(list_t *list, void *e, size_t size, list_position_t position) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* The list must release the elements, shared copies and elements stored in the arena are released differently */
+    if ((false == list->alloc) || (true == list->arena) || (true == list->shared)) {
+        return -1;
+    }
+
+    uint64_t start = LIST_PROBE_START(add);
+
+    /* Create a new list element, the list is locked */
+    list_element_t *list_element = list_create_locked(list, NULL, 0, LIST_ADD_OP(position));
+    if (NULL == list_element) {
+        /* Unable to create list element */
+        return -1;
+    }
+    list_element->e                      = e;
+    LIST_COPY(list, list_element)->size  = size;
+    LIST_COPY(list, list_element)->owned = true;
+
+    /* Add element to the list */
+    return list_add_node(list, list_element, position, start);
+}
+
+/**
+ * @brief Allocate a list element, the list must be locked if list elements are allocated in the arena
+ * @param list List instance
+ * @param size Size of the element copied just after the list element, arena only
+ * @param locked true if the list is locked, list elements kept for future allocations are used only if the list is locked
+ * @return List element if the function succeeded, NULL otherwise
+ */
+static list_element_t *
+list_alloc_node(list_t *list, size_t size, bool locked) {
+
+    assert(NULL != list);
+
+    /* Create a new list element, the node of the order statistic index is stored just after the element */
+    list_element_t *list_element = NULL;
+    if ((true == locked) && (NULL != (list_element = list->cache))) {
+        /* Use a list element kept for future allocations */
+        list->cache = list_element->next;
+        __atomic_store_n(&list->cached, list->cached - 1, __ATOMIC_RELAXED);
+    }
+    if (NULL != list_element) {
+        /* List element found in the cache */
+    } else if (true == list->arena) {
+        list_element = (list_element_t *)list_arena_alloc(list, list->node_size + size);
+    } else if (true == list->thread_cache) {
+        list_element = (list_element_t *)list_cache_alloc(list->node_size);
+    } else {
+        list_element = (list_element_t *)list_alloc_memory(list, list->node_size);
+    }
+    if (NULL == list_element) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+    memset(list_element, 0, list->node_size - list->inline_size);
+    if (true == list->indexed) {
+        LIST_RANK(list_element)->element = list_element;
+    }
+
+    return list_element;
+}
+
+/**
+ * @brief Create a list element and lock the list, list elements of the arena or kept for future allocations are allocated once the list is locked so that adding an element locks the list once
+ * @param list List instance
+ * @param e Element to be added in the list, NULL to allocate the list element only
+ * @param size Size of the element to be added
+ * @param op Operation locking the list
+ * @return List element if the function succeeded and the list is locked, NULL otherwise and the list is not locked
+ */
+static list_element_t *
+list_create_locked(list_t *list, void *e, size_t size, list_op_t op) {
+
+    assert(NULL != list);
+
+    list_element_t *list_element = NULL;
+
+    /* Allocate the list element in the arena or use a list element kept for future allocations while the list is locked, other list elements are allocated before locking the list */
+    if ((true == list->arena) || (0 != __atomic_load_n(&list->cached, __ATOMIC_RELAXED))) {
+        list_lock(list, op);
+        list_element = (NULL != e) ? list_create_element(list, e, size, true) : list_alloc_node(list, 0, true);
+        if (NULL == list_element) {
+            /* Unable to create list element */
+            list_unlock(list);
+        }
+    } else {
+        list_element = (NULL != e) ? list_create_element(list, e, size, false) : list_alloc_node(list, 0, false);
+        if (NULL != list_element) {
+            list_lock(list, op);
+        }
+    }
+
+    return list_element;
+}
+
+/**
+ * @brief Create a list element, the list must be locked if list elements are allocated in the arena
+ * @param list List instance
+ * @param e Element to be added in the list
+ * @param size Size of the element to be added
+ * @param locked true if the list is locked
+ * @return List element if the function succeeded, NULL otherwise
+ */
+static list_element_t *
+list_create_element(list_t *list, void *e, size_t size, bool locked) {
+
+    assert(NULL != list);
+    assert(NULL != e);
+
+    /* Create a new list element, the element itself is stored just after the list element in the arena */
+    list_element_t *list_element = list_alloc_node(list, ((true == list->alloc) && (false == list->shared)) ? size : 0, locked);
+    if (NULL == list_element) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+
+    /* Store element */
+    if ((true == list->alloc) && (true == list->arena) && (false == list->shared)) {
+        list_element->e                     = (unsigned char *)list_element + list->node_size;
+        LIST_COPY(list, list_element)->size = size;
+        memcpy(list_element->e, e, size);
+    } else if ((true == list->alloc) && (size <= list->inline_size)) {
+        list_element->e                     = (unsigned char *)list_element + (list->node_size - list->inline_size);
+        LIST_COPY(list, list_element)->size = size;
+        memcpy(list_element->e, e, size);
+    } else if (true == list->alloc) {
+        if (NULL == (list_element->e = list_alloc_payload(list, size))) {
+            /* Unable to allocate memory */
+            list_release_node(list, list_element);
+            return NULL;
+        }
+        LIST_COPY(list, list_element)->size = size;
+        memcpy(list_element->e, e, size);
+    } else {
+        list_element->e = e;
+    }
+
+    return list_element;
+}
+
+/**
+ * @brief Release a list element and the element itself if it has been allocated
+ * @param list List instance
+ * @param list_element List element
+ */
+static void
+list_release_element(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Release memory */
+    list_release_copy(list, list_element);
+    list_release_node(list, list_element);
+}
+
+/**
+ * @brief Release the element itself if it has been allocated
+ * @param list List instance
+ * @param list_element List element
+ */
+static void
+list_release_copy(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Nothing to release if elements are not allocated */
+    if (false == list->alloc) {
+        return;
+    }
+
+    /* Release memory, elements allocated by the caller are not stored in the pools */
+    list_copy_t *copy = LIST_COPY(list, list_element);
+    if (true == copy->owned) {
+        list_free_memory(list, list_element->e, copy->size);
+    } else if (((false == list->arena) || (true == list->shared)) && (NULL != list_element->e) && (false == list_is_inline(list, list_element))) {
+        list_free_payload(list, list_element->e, copy->size);
+    }
+}
+
+/**
+ * @brief Release list elements from the head of the list, the list must be locked and is no longer usable until it is reset
+ * @param list List instance
+ * @param budget Maximum number of elements released, 0 to release all the elements
+ * @param keep true to keep the current chunk of the arena for future allocations
+ * @return Number of elements released
+ */
+static size_t
+list_release_elements(list_t *list, size_t budget, bool keep) {
+
+    assert(NULL != list);
+
+    size_t count = 0;
+
+    /* Release list elements, elements stored in the arena are released at once */
+    if ((true == list->arena) && (false == list->shared)) {
+        count       = list->count;
+        list->count = 0;
+    } else {
+        while ((0 < list->count) && ((0 == budget) || (count < budget))) {
+            list_element_t *list_element;
+            if (LIST_MODE_HEAP == list->mode) {
+                list_element = list->heap[list->count - 1];
+            } else {
+                list_element = list->first;
+                list->first  = list_element->next;
+            }
+            list->count--;
+            if ((true == keep) && (false == list->arena)) {
+                /* Keep the list element for future allocations */
+                list_release_copy(list, list_element);
+                list_element->next = list->cache;
+                list->cache        = list_element;
+                __atomic_store_n(&list->cached, list->cached + 1, __ATOMIC_RELAXED);
+            } else {
+                list_release_element(list, list_element);
+            }
+            count++;
+        }
+    }
+
+    /* Release the arena once all the elements are released */
+    if ((0 == list->count) && (true == list->arena)) {
+        list_arena_release(list, keep);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Reset the list once the elements have been released, the list must be locked
+ * @param list List instance
+ */
+static void
+list_reset_elements(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Reset the list */
+    list->first    = NULL;
+    list->last     = NULL;
+    list->curr     = NULL;
+    list->count    = 0;
+    list->expiring = 0;
+    list->sweep    = NULL;
+    list->root     = NULL;
+    list->bytes    = 0;
+}
+
+/**
+ * @brief Release memory kept by the list for future allocations, the list must be locked
+ * @param list List instance
+ * @return Number of bytes released
+ */
+static size_t
+list_release_cached(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Release list elements kept for future allocations */
+    size_t bytes = list->cached * list->node_size;
+    while (NULL != list->cache) {
+        list_element_t *list_element = list->cache;
+        list->cache                  = list_element->next;
+        list_release_node(list, list_element);
+    }
+    __atomic_store_n(&list->cached, 0, __ATOMIC_RELAXED);
+
+    /* Release blocks of the pools if all their slots are free */
+    if (NULL != list->pools) {
+        if (LIST_LOCK_NONE != list->lock) {
+            pthread_mutex_lock(&list->pools->mutex);
+        }
+        for (size_t index = 0; index < list->pools->count; index++) {
+            list_pool_t *pool = &list->pools->pool[index];
+            if (0 == pool->used) {
+                bytes += pool->held;
+                while (NULL != pool->blocks) {
+                    list_block_t *block = pool->blocks;
+                    pool->blocks        = block->next;
+                    list_free_memory(list, block, block->size);
+                }
+                pool->slots = NULL;
+                pool->held  = 0;
+            }
+        }
+        if (LIST_LOCK_NONE != list->lock) {
+            pthread_mutex_unlock(&list->pools->mutex);
+        }
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief Release list instance once the elements have been released
+ * @param list List instance
+ */
+static void
+list_destroy(list_t *list) {
+
+    assert(NULL != list);
+
+    /* Release memory kept for future allocations */
+    list_release_cached(list);
+
+    /* Release list elements of the elements allocated by the caller removed but not released by the caller */
+    while (NULL != list->detached) {
+        list_element_t *list_element = list->detached;
+        list->detached               = list_element->next;
+        list_release_node(list, list_element);
+    }
+
+    /* Release heap */
+    free(list->heap);
+
+    /* Release pools, including blocks of the elements removed but not released by the caller */
+    if (NULL != list->pools) {
+        for (size_t index = 0; index < list->pools->count; index++) {
+            list_block_t *block = list->pools->pool[index].blocks;
+            while (NULL != block) {
+                list_block_t *tmp = block;
+                block             = block->next;
+                list_free_memory(list, tmp, tmp->size);
+            }
+        }
+        pthread_mutex_destroy(&list->pools->mutex);
+        list_free_memory(list, list->pools, sizeof(list_pools_t) + list->pools->count * sizeof(list_pool_t));
+    }
+
+    /* Release semaphore */
+    sem_close(&list->sem);
+
+    /* Release list instance */
+    free(list);
+}
+
+/**
+ * @brief Reclaim thread releasing elements of the lists released asynchronously
+ * @param arg Unused
+ * @return Unused
+ */
+static void *
+list_reclaim_handler(void *arg) {
+
+    (void)arg;
+
+    /* Release elements by batches until the thread is stopped and all the lists are released */
+    pthread_mutex_lock(&list_reclaim_mutex);
+    while ((true == list_reclaim_running) || (NULL != list_reclaim_first)) {
+        if (NULL == list_reclaim_first) {
+            pthread_cond_wait(&list_reclaim_cond, &list_reclaim_mutex);
+        } else {
+            pthread_mutex_unlock(&list_reclaim_mutex);
+            list_reclaim(LIST_RECLAIM_BATCH);
+            pthread_mutex_lock(&list_reclaim_mutex);
+        }
+    }
+    pthread_mutex_unlock(&list_reclaim_mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Release a list element without the element itself
+ * @param list List instance
+ * @param list_element List element
+ */
+static void
+list_release_node(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Memory of the arena is released with the list */
+    if (true == list->thread_cache) {
+        list_cache_free(list->node_size, list_element);
+    } else if (false == list->arena) {
+        list_free_memory(list, list_element, list->node_size);
+    }
+}
+
+/**
+ * @brief Check if the element is copied in the list element itself
+ * @param list List instance
+ * @param list_element List element
+ * @return true if the element is copied in the list element, false otherwise
+ */
+static bool
+list_is_inline(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    return (0 != list->inline_size) && (list_element->e == (unsigned char *)list_element + (list->node_size - list->inline_size));
+}
+
+/**
+ * @brief Check if a list element must be kept when its element is returned to the caller, the list must be locked
+ * @param list List instance
+ * @param list_element List element, unlinked from the list
+ * @return true if the list element is kept until the element is released using list_free_element, false otherwise
+ */
+static bool
+list_keep_node(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* The element is copied in the list element */
+    if (true == list_is_inline(list, list_element)) {
+        return true;
+    }
+
+    /* Nothing to keep if elements are not allocated */
+    if (false == list->alloc) {
+        return false;
+    }
+
+    /* The list element of an element allocated by the caller is kept so that list_free_element knows how to release the element */
+    list_copy_t *copy = LIST_COPY(list, list_element);
+    if (true == copy->owned) {
+        list_element->next = list->detached;
+        __atomic_store_n(&list->detached, list_element, __ATOMIC_RELAXED);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Get expiry time of a list element
  * @param list List instance
- * @param e Element to be added in the list
- * @param size Size of the element to be added
- * @return 0 if the function succeeded, -1 otherwise
+ * @param list_element List element
+ * @return Expiry time of the list element, 0 if the element never expires or if the expiry time is not stored in the list elements
  */
-static list_element_t *list_create_element(list_t *list, void *e, size_t size);
+static inline uint64_t
+list_get_expiry(list_t *list, list_element_t *list_element) {
 
-/******************************************************************************/
-/* Functions                                                                  */
-/******************************************************************************/
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    return (0 != list->expiry_offset) ? LIST_EXPIRY(list, list_element) : 0;
+}
 
 /**
- * @brief Function used to create list instance
- * @param alloc true if element should be allocated when they are added in the list, false for a copy only
- * @param sort Callback function invoked to sort elements of the list, NULL if not used
- * @return List instance if the function succeeded, NULL otherwise
+ * @brief Get size of the copy of an element
+ * @param list List instance
+ * @param list_element List element
+ * @return Size of the copy of the element, 0 if elements are not allocated
  */
-list_t *
-list_create(bool alloc, bool (*sort)(list_t *, void *, void *)) {
+static inline size_t
+list_get_size(list_t *list, list_element_t *list_element) {
 
-    /* Create list instance */
-    list_t *list = (list_t *)malloc(sizeof(list_t));
-    if (NULL == list) {
-        /* Unable to allocate memory */
-        return NULL;
-    }
-    memset(list, 0, sizeof(list_t));
+    assert(NULL != list);
+    assert(NULL != list_element);
 
-    /* Save alloc flag */
-    list->alloc = alloc;
+    return (true == list->alloc) ? LIST_COPY(list, list_element)->size : 0;
+}
 
-    /* Save sort callback */
-    list->sort = sort;
+/**
+ * @brief Link a list element in the list, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @param position Position of the element in the list
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int
+list_link_element(list_t *list, list_element_t *list_element, list_position_t position) {
 
-    /* Initialize semaphore used to access the list */
-    sem_init(&list->sem, 0, 1);
+    assert(NULL != list);
+    assert(NULL != list_element);
 
-    return list;
+    /* Elements of the heap are always ordered using the sort callback */
+    if (LIST_MODE_HEAP == list->mode) {
+        return list_heap_push(list, list_element);
+    }
+
+    /* Search the element before which the new element must be added */
+    list_element_t *next = NULL;
+    if (LIST_POSITION_HEAD == position) {
+        next = list->first;
+    } else if ((LIST_POSITION_SORTED == position) && (NULL != list->sort)) {
+        /* Invoke sort callback to know before which element the new element must be added */
+        next = list->first;
+        while ((NULL != next) && (true == list_sort_element(list, next->e, list_element->e))) {
+            next = next->next;
+        }
+    }
+
+    /* Add element to the list */
+    list_link_element_before(list, list_element, next);
+
+    return 0;
 }
 
 /**
- * @brief Add element to the the list
+ * @brief Link a list element in the list just before another list element, the list must be locked, not available in heap mode
  * @param list List instance
- * @param e Element to be added in the list
- * @param size Size of the element to be added
- * @return 0 if the function succeeded, -1 otherwise
+ * @param list_element List element
+ * @param next List element before which the list element is added, NULL to add it at the end of the list
  */
-int
-list_add(list_t *list, void *e, size_t size) {
+static void
+list_link_element_before(list_t *list, list_element_t *list_element, list_element_t *next) {
 
     assert(NULL != list);
-    assert(NULL != e);
+    assert(NULL != list_element);
+    assert(LIST_MODE_HEAP != list->mode);
 
-    /* Create a new list element */
-    list_element_t *list_element = list_create_element(list, e, size);
-    if (NULL == list_element) {
-        /* Unable to create list element */
-        return -1;
+    /* Update number of elements with an expiry time */
+    if (0 != list_get_expiry(list, list_element)) {
+        list->expiring++;
     }
 
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
     /* Add element to the list */
     if (NULL == list->first) {
-        list->last = list->first = list->curr = list_element;
-    } else if (NULL != list->sort) {
-        list_element_t *tmp = list->first;
-        while (NULL != tmp) {
-            /* Invoke sort callback to know if the new element must be added before the current element */
-            if (false == list->sort(list, tmp->e, e)) {
-                /* Element must be added just before the current element */
-                if (NULL == tmp->prev) {
-                    list->first = list_element;
-                } else {
-                    tmp->prev->next    = list_element;
-                    list_element->prev = tmp->prev;
-                }
-                list_element->next = tmp;
-                tmp->prev          = list_element;
-                goto ADDED;
-            }
-            tmp = tmp->next;
+        list->first = list->last = list->curr = list_element;
+    } else if (NULL != next) {
+        /* Element must be added just before the next element */
+        if (NULL == next->prev) {
+            list->first = list_element;
+        } else {
+            next->prev->next   = list_element;
+            list_element->prev = next->prev;
         }
-        /* End of the list reached, element must be added at the end of the list */
-        list->last->next   = list_element;
-        list_element->prev = list->last;
-        list->last         = list_element;
+        list_element->next = next;
+        next->prev         = list_element;
     } else {
+        /* Element must be added at the end of the list */
         list->last->next   = list_element;
         list_element->prev = list->last;
         list->last         = list_element;
     }
-ADDED:
     list->count++;
+    list->bytes += list_get_size(list, list_element);
+    LIST_STATS_ADD(list, adds, 1);
 
-    /* Release semaphore */
-    sem_post(&list->sem);
+    /* Add element to the order statistic index */
+    if (true == list->indexed) {
+        list_rank_insert(list, LIST_RANK(list_element), (NULL != next) ? LIST_RANK(next) : NULL);
+    }
+}
+
+/**
+ * @brief Unlink a list element from the list, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ */
+static void
+list_unlink_element(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Update number of elements with an expiry time */
+    if (0 != list_get_expiry(list, list_element)) {
+        list->expiring--;
+    }
+
+    /* Update number of bytes of the copy of the elements */
+    list->bytes -= list_get_size(list, list_element);
+    LIST_STATS_ADD(list, removes, 1);
+
+    /* Update next element to be checked when expiring elements of the list if required */
+    if (list_element == list->sweep) {
+        list->sweep = (LIST_MODE_HEAP == list->mode) ? NULL : list_element->next;
+    }
+
+    /* Remove element from the heap */
+    if (LIST_MODE_HEAP == list->mode) {
+        list_heap_remove(list, list_element);
+        return;
+    }
+
+    /* Update first element if required */
+    if (list_element == list->first) {
+        list->first = list_element->next;
+    }
+
+    /* Update last element if required */
+    if (list_element == list->last) {
+        list->last = list_element->prev;
+    }
+
+    /* Update current element if required */
+    if (list_element == list->curr) {
+        list->curr = list_element->prev;
+    }
+
+    /* Update the list */
+    if (NULL != list_element->prev) {
+        list_element->prev->next = list_element->next;
+    }
+    if (NULL != list_element->next) {
+        list_element->next->prev = list_element->prev;
+    }
+    list_element->prev = list_element->next = NULL;
+    list->count--;
+
+    /* Remove element from the order statistic index */
+    if (true == list->indexed) {
+        list_rank_remove(list, LIST_RANK(list_element));
+    }
+}
+
+/**
+ * @brief Get the list element at the wanted position, the list must be locked
+ * @param list List instance
+ * @param index Position of the list element
+ * @return List element, NULL if the position is out of the list
+ */
+static list_element_t *
+list_get_element_at(list_t *list, size_t index) {
+
+    assert(NULL != list);
+
+    /* Check position */
+    if (index >= list->count) {
+        return NULL;
+    }
+
+    /* Elements of the heap are directly accessed in the heap array */
+    if (LIST_MODE_HEAP == list->mode) {
+        return list->heap[index];
+    }
+
+    /* Search the element in the order statistic index */
+    if (true == list->indexed) {
+        list_rank_t *rank = list->root;
+        while (index != list_rank_size(rank->left)) {
+            if (index < list_rank_size(rank->left)) {
+                rank = rank->left;
+            } else {
+                index -= list_rank_size(rank->left) + 1;
+                rank = rank->right;
+            }
+        }
+        return rank->element;
+    }
+
+    /* Parse the list from the nearest end */
+    list_element_t *list_element;
+    if (index < list->count / 2) {
+        list_element = list->first;
+        while (0 < index--) {
+            list_element = list_element->next;
+        }
+    } else {
+        list_element = list->last;
+        for (size_t tmp = list->count - 1; tmp > index; tmp--) {
+            list_element = list_element->prev;
+        }
+    }
+
+    return list_element;
+}
+
+/**
+ * @brief Get the list element following a list element, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @return Next list element, NULL if the end of the list is reached
+ */
+static list_element_t *
+list_get_next_element(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Elements of the heap are parsed in the order of the heap array */
+    if (LIST_MODE_HEAP == list->mode) {
+        return (LIST_POS(list, list_element) + 1 < list->count) ? list->heap[LIST_POS(list, list_element) + 1] : NULL;
+    }
+
+    return list_element->next;
+}
+
+/**
+ * @brief Get the list element preceding a list element, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @return Previous list element, NULL if the beginning of the list is reached
+ */
+static list_element_t *
+list_get_prev_element(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Elements of the heap are parsed in the order of the heap array */
+    if (LIST_MODE_HEAP == list->mode) {
+        return (0 < LIST_POS(list, list_element)) ? list->heap[LIST_POS(list, list_element) - 1] : NULL;
+    }
+
+    return list_element->prev;
+}
+
+/**
+ * @brief Remove expired list elements starting from a list element, the list must be locked
+ * @param list List instance
+ * @param list_element List element
+ * @param forward true to parse the list forward, false to parse it backward
+ * @return First list element which is not expired, NULL if the end of the list is reached
+ */
+static list_element_t *
+list_skip_expired(list_t *list, list_element_t *list_element, bool forward) {
+
+    assert(NULL != list);
+
+    /* Nothing to do if no element of the list has an expiry time */
+    if (0 == list->expiring) {
+        return list_element;
+    }
+
+    /* Remove expired elements */
+    uint64_t now = list->clock();
+    while ((NULL != list_element) && (0 != LIST_EXPIRY(list, list_element)) && (LIST_EXPIRY(list, list_element) <= now)) {
+        list_element_t *tmp = list_element;
+
+        /* Heap order is restored after each removal, the element at the same position of the heap array is checked next, so the head is always the minimum */
+        if (LIST_MODE_HEAP == list->mode) {
+            size_t pos = LIST_POS(list, tmp);
+            list_unlink_element(list, tmp);
+            list_release_element(list, tmp);
+            if (true == forward) {
+                list_element = (pos < list->count) ? list->heap[pos] : NULL;
+            } else {
+                list_element = (0 < pos) ? list->heap[pos - 1] : NULL;
+            }
+            continue;
+        }
+
+        list_element = (true == forward) ? list_get_next_element(list, tmp) : list_get_prev_element(list, tmp);
+        list_unlink_element(list, tmp);
+        list_release_element(list, tmp);
+    }
+
+    return list_element;
+}
+
+/**
+ * @brief Get current time in milliseconds using monotonic clock
+ * @return Current time in milliseconds
+ */
+static uint64_t
+list_clock_monotonic(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Push a list element in the heap
+ * @param list List instance
+ * @param list_element List element
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+static int
+list_heap_push(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    /* Increase capacity of the heap if required */
+    if (list->count >= list->capacity) {
+        size_t           capacity = (0 < list->capacity) ? (2 * list->capacity) : LIST_HEAP_INITIAL_CAPACITY;
+        list_element_t **heap     = (list_element_t **)realloc(list->heap, capacity * sizeof(list_element_t *));
+        if (NULL == heap) {
+            /* Unable to allocate memory */
+            return -1;
+        }
+        list->heap     = heap;
+        list->capacity = capacity;
+    }
+
+    /* Update number of elements with an expiry time */
+    if (0 != list_get_expiry(list, list_element)) {
+        list->expiring++;
+    }
+
+    /* Update current element if required */
+    if (NULL == list->first) {
+        list->curr = list_element;
+    }
+
+    /* Add element at the end of the heap and restore heap ordering */
+    list->heap[list->count]      = list_element;
+    LIST_POS(list, list_element) = list->count;
+    list->count++;
+    list->bytes += list_get_size(list, list_element);
+    LIST_STATS_ADD(list, adds, 1);
+    list_heap_sift_up(list, LIST_POS(list, list_element));
+    list_heap_update_bounds(list);
 
     return 0;
 }
 
 /**
- * @brief Add element to the head of the list
+ * @brief Remove a list element from the heap
+ * @param list List instance
+ * @param list_element List element
+ */
+static void
+list_heap_remove(list_t *list, list_element_t *list_element) {
+
+    assert(NULL != list);
+    assert(NULL != list_element);
+
+    size_t pos = LIST_POS(list, list_element);
+
+    /* Update current element if required */
+    if (list_element == list->curr) {
+        list->curr = (0 < pos) ? list->heap[pos - 1] : NULL;
+    }
+
+    /* Replace the element by the last element of the heap and restore heap ordering */
+    list->count--;
+    if (pos < list->count) {
+        list->heap[pos]                 = list->heap[list->count];
+        LIST_POS(list, list->heap[pos]) = pos;
+        list_heap_sift_down(list, list_heap_sift_up(list, pos));
+    }
+    list->heap[list->count] = NULL;
+    list_heap_update_bounds(list);
+}
+
+/**
+ * @brief Move a list element up in the heap until heap ordering is restored
+ * @param list List instance
+ * @param pos Position of the list element in the heap
+ * @return New position of the list element in the heap
+ */
+static size_t
+list_heap_sift_up(list_t *list, size_t pos) {
+
+    assert(NULL != list);
+    assert(pos < list->count);
+
+    list_element_t *list_element = list->heap[pos];
+
+    /* Move parents down while the element must be before them */
+    while (0 < pos) {
+        size_t parent = (pos - 1) / 2;
+        if (false == list_sort_element(list, list_element->e, list->heap[parent]->e)) {
+            break;
+        }
+        list->heap[pos]                 = list->heap[parent];
+        LIST_POS(list, list->heap[pos]) = pos;
+        pos                             = parent;
+    }
+    list->heap[pos]              = list_element;
+    LIST_POS(list, list_element) = pos;
+
+    return pos;
+}
+
+/**
+ * @brief Move a list element down in the heap until heap ordering is restored
+ * @param list List instance
+ * @param pos Position of the list element in the heap
+ */
+static void
+list_heap_sift_down(list_t *list, size_t pos) {
+
+    assert(NULL != list);
+    assert(pos < list->count);
+
+    list_element_t *list_element = list->heap[pos];
+
+    /* Move children up while they must be before the element */
+    size_t child;
+    while ((child = 2 * pos + 1) < list->count) {
+        if ((child + 1 < list->count) && (true == list_sort_element(list, list->heap[child + 1]->e, list->heap[child]->e))) {
+            child++;
+        }
+        if (false == list_sort_element(list, list->heap[child]->e, list_element->e)) {
+            break;
+        }
+        list->heap[pos]                 = list->heap[child];
+        LIST_POS(list, list->heap[pos]) = pos;
+        pos                             = child;
+    }
+    list->heap[pos]              = list_element;
+    LIST_POS(list, list_element) = pos;
+}
+
+/**
+ * @brief Update first and last elements of the list from the heap
+ * @param list List instance
+ */
+static void
+list_heap_update_bounds(list_t *list) {
+
+    assert(NULL != list);
+
+    list->first = (0 < list->count) ? list->heap[0] : NULL;
+    list->last  = (0 < list->count) ? list->heap[list->count - 1] : NULL;
+}
+
+/**
+ * @brief Add a node to the order statistic index just before another node
+ * @param list List instance
+ * @param rank Node to be added
+ * @param next Node before which the node is added, NULL to add it at the end
+ */
+static void
+list_rank_insert(list_t *list, list_rank_t *rank, list_rank_t *next) {
+
+    assert(NULL != list);
+    assert(NULL != rank);
+
+    /* Initialize the node, the priority is derived from its address */
+    uint64_t priority = (uint64_t)(uintptr_t)rank;
+    priority ^= priority >> 33;
+    priority *= 0xff51afd7ed558ccdULL;
+    priority ^= priority >> 33;
+    rank->parent = rank->left = rank->right = NULL;
+    rank->size                              = 1;
+    rank->priority                          = priority;
+
+    /* First node of the index */
+    if (NULL == list->root) {
+        list->root = rank;
+        return;
+    }
+
+    /* The node is added as the right child of the last node before the next node, or as the left child of the next node */
+    list_rank_t *parent;
+    if (NULL == next) {
+        parent = list->root;
+        while (NULL != parent->right) {
+            parent = parent->right;
+        }
+        parent->right = rank;
+    } else if (NULL == next->left) {
+        parent     = next;
+        next->left = rank;
+    } else {
+        parent = next->left;
+        while (NULL != parent->right) {
+            parent = parent->right;
+        }
+        parent->right = rank;
+    }
+    rank->parent = parent;
+
+    /* Update number of nodes of the subtrees */
+    for (list_rank_t *tmp = parent; NULL != tmp; tmp = tmp->parent) {
+        tmp->size++;
+    }
+
+    /* Rotate the node up to restore priority ordering */
+    while ((NULL != rank->parent) && (rank->priority > rank->parent->priority)) {
+        list_rank_rotate(list, rank);
+    }
+}
+
+/**
+ * @brief Remove a node from the order statistic index
  * @param list List instance
- * @param e Element to be added in the list
- * @param size Size of the element to be added
- * @return 0 if the function succeeded, -1 otherwise
+ * @param rank Node to be removed
  */
-int
-list_add_head(list_t *list, void *e, size_t size) {
+static void
+list_rank_remove(list_t *list, list_rank_t *rank) {
 
     assert(NULL != list);
-    assert(NULL != e);
+    assert(NULL != rank);
 
-    /* Create a new list element */
-    list_element_t *list_element = list_create_element(list, e, size);
-    if (NULL == list_element) {
-        /* Unable to create list element */
-        return -1;
+    /* Rotate the node down until it is a leaf */
+    while ((NULL != rank->left) || (NULL != rank->right)) {
+        if ((NULL == rank->right) || ((NULL != rank->left) && (rank->left->priority > rank->right->priority))) {
+            list_rank_rotate(list, rank->left);
+        } else {
+            list_rank_rotate(list, rank->right);
+        }
     }
 
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
-    /* Add element to the list */
-    if (NULL == list->first) {
-        list->first = list->last = list->curr = list_element;
+    /* Remove the leaf */
+    list_rank_t *parent = rank->parent;
+    if (NULL == parent) {
+        list->root = NULL;
+    } else if (rank == parent->left) {
+        parent->left = NULL;
     } else {
-        list->first->prev  = list_element;
-        list_element->next = list->first;
-        list->first        = list_element;
+        parent->right = NULL;
     }
-    list->count++;
-
-    /* Release semaphore */
-    sem_post(&list->sem);
+    rank->parent = NULL;
 
-    return 0;
+    /* Update number of nodes of the subtrees */
+    for (list_rank_t *tmp = parent; NULL != tmp; tmp = tmp->parent) {
+        tmp->size--;
+    }
 }
 
 /**
- * @brief Add element to the tail of the list
+ * @brief Rotate a node of the order statistic index above its parent
  * @param list List instance
- * @param e Element to be added in the list
- * @param size Size of the element to be added
- * @return 0 if the function succeeded, -1 otherwise
+ * @param rank Node to be rotated
  */
-int
-list_add_tail(list_t *list, void *e, size_t size) {
+static void
+list_rank_rotate(list_t *list, list_rank_t *rank) {
 
     assert(NULL != list);
-    assert(NULL != e);
+    assert(NULL != rank);
+    assert(NULL != rank->parent);
 
-    /* Create a new list element */
-    list_element_t *list_element = list_create_element(list, e, size);
-    if (NULL == list_element) {
-        /* Unable to create list element */
-        return -1;
-    }
+    list_rank_t *parent      = rank->parent;
+    list_rank_t *grandparent = parent->parent;
 
-    /* Wait semaphore */
-    sem_wait(&list->sem);
+    /* Move the subtree between the node and its parent */
+    if (rank == parent->left) {
+        parent->left = rank->right;
+        if (NULL != rank->right) {
+            rank->right->parent = parent;
+        }
+        rank->right = parent;
+    } else {
+        parent->right = rank->left;
+        if (NULL != rank->left) {
+            rank->left->parent = parent;
+        }
+        rank->left = parent;
+    }
+    parent->parent = rank;
 
-    /* Add element to the list */
-    if (NULL == list->last) {
-        list->last = list->first = list->curr = list_element;
+    /* Attach the node to the grandparent */
+    rank->parent = grandparent;
+    if (NULL == grandparent) {
+        list->root = rank;
+    } else if (parent == grandparent->left) {
+        grandparent->left = rank;
     } else {
-        list->last->next   = list_element;
-        list_element->prev = list->last;
-        list->last         = list_element;
+        grandparent->right = rank;
     }
-    list->count++;
 
-    /* Release semaphore */
-    sem_post(&list->sem);
+    /* Update number of nodes of the subtrees */
+    rank->size   = parent->size;
+    parent->size = list_rank_size(parent->left) + list_rank_size(parent->right) + 1;
+}
 
-    return 0;
+/**
+ * @brief Get number of nodes of a subtree of the order statistic index
+ * @param rank Root node of the subtree, NULL if the subtree is empty
+ * @return Number of nodes of the subtree
+ */
+static size_t
+list_rank_size(list_rank_t *rank) {
+
+    return (NULL != rank) ? rank->size : 0;
 }
 
 /**
- * @brief Get number of element in the list
+ * @brief Allocate memory in the arena, the list must be locked
  * @param list List instance
- * @return Number of elements in the list
+ * @param size Size of the memory
+ * @return Allocated memory, NULL if an error occurred
  */
-size_t
-list_get_count(list_t *list) {
+static void *
+list_arena_alloc(list_t *list, size_t size) {
 
     assert(NULL != list);
 
-    size_t count = 0;
+    size_t        offset = LIST_ARENA_ALIGN(sizeof(list_chunk_t));
+    list_chunk_t *chunk  = list->chunks;
 
-    /* Wait semaphore */
-    sem_wait(&list->sem);
+    /* Allocate memory in the current chunk if possible */
+    size = LIST_ARENA_ALIGN(size);
+    if ((NULL != chunk) && (chunk->used + size <= chunk->size)) {
+        void *memory = (unsigned char *)chunk + offset + chunk->used;
+        chunk->used += size;
+        return memory;
+    }
 
-    /* Get number of elements */
-    count = list->count;
+    /* Create a new chunk, large allocations have their own chunk */
+    size_t length = (size > LIST_ARENA_CHUNK_SIZE - offset) ? size : LIST_ARENA_CHUNK_SIZE - offset;
+    chunk         = (list_chunk_t *)list_alloc_memory(list, offset + length);
+    if (NULL == chunk) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+    chunk->size = length;
+    chunk->used = size;
 
-    /* Release semaphore */
-    sem_post(&list->sem);
+    /* Add the chunk to the arena, the current chunk remains the first one if the new chunk is full */
+    if ((NULL != list->chunks) && (chunk->used == chunk->size)) {
+        chunk->next        = list->chunks->next;
+        list->chunks->next = chunk;
+    } else {
+        chunk->next  = list->chunks;
+        list->chunks = chunk;
+    }
 
-    return count;
+    return (unsigned char *)chunk + offset;
 }
 
 /**
- * @brief Get head element of the list
+ * @brief Release chunks of memory of the arena, the list must be locked
  * @param list List instance
- * @return Head element of the list, NULL if the list is empty
+ * @param keep true to keep the current chunk for future allocations
  */
-void *
-list_get_head(list_t *list) {
+static void
+list_arena_release(list_t *list, bool keep) {
 
     assert(NULL != list);
 
-    void *e = NULL;
-
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
-    /* Get head list element */
-    list->curr = list->first;
-
-    /* Get element */
-    if (NULL != list->curr) {
-        e = list->curr->e;
+    /* Keep the current chunk if wanted */
+    list_chunk_t *chunk = list->chunks;
+    if ((true == keep) && (NULL != chunk)) {
+        chunk->used        = 0;
+        chunk              = chunk->next;
+        list->chunks->next = NULL;
+    } else {
+        list->chunks = NULL;
     }
 
-    /* Release semaphore */
-    sem_post(&list->sem);
-
-    return e;
+    /* Release chunks */
+    while (NULL != chunk) {
+        list_chunk_t *tmp = chunk;
+        chunk             = chunk->next;
+        list_free_memory(list, tmp, LIST_ARENA_ALIGN(sizeof(list_chunk_t)) + tmp->size);
+    }
 }
 
 /**
- * @brief Get tail element of the list
+ * @brief Allocate memory using the allocator of the list
  * @param list List instance
- * @return Tail element of the list, NULL if the list is empty
+ * @param size Size of the memory
+ * @return Allocated memory, NULL if an error occurred
  */
-void *
-list_get_tail(list_t *list) {
+static void *
+list_alloc_memory(list_t *list, size_t size) {
 
     assert(NULL != list);
 
-    void *e = NULL;
-
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
-    /* Get last list element */
-    list->curr = list->last;
-
-    /* Get element */
-    if (NULL != list->curr) {
-        e = list->curr->e;
+    /* Use the allocator of the list if defined */
+    if (NULL != list->allocator.alloc) {
+        return list->allocator.alloc(size, list->allocator.ctx);
     }
 
-    /* Release semaphore */
-    sem_post(&list->sem);
-
-    return e;
+    return malloc(size);
 }
 
 /**
- * @brief Get next element of the list
+ * @brief Release memory using the allocator of the list
  * @param list List instance
- * @return Next element of the list, NULL if the end of the list is reached
+ * @param ptr Memory to be released
+ * @param size Size of the memory
  */
-void *
-list_get_next(list_t *list) {
+static void
+list_free_memory(list_t *list, void *ptr, size_t size) {
 
     assert(NULL != list);
 
-    void *e = NULL;
+    /* Use the allocator of the list if defined */
+    if (NULL != list->allocator.free) {
+        list->allocator.free(ptr, size, list->allocator.ctx);
+    } else {
+        free(ptr);
+    }
+}
+
+/**
+ * @brief Allocate a list element from the cache of the current thread
+ * @param size Size of the list element
+ * @return Allocated list element, NULL if an error occurred
+ */
+static void *
+list_cache_alloc(size_t size) {
 
-    /* Wait semaphore */
-    sem_wait(&list->sem);
+    size_t index = (size - LIST_ARENA_ALIGN(sizeof(list_element_t))) / (2 * sizeof(void *));
+    assert(LIST_CACHE_CLASSES > index);
 
-    /* Get next list element */
-    if (NULL != list->curr) {
-        list->curr = list->curr->next;
+    list_cache_t *cache = &list_cache[index];
+
+    /* Refill the cache with a batch of the global pool if it is empty */
+    if (NULL == cache->nodes) {
+        list_cache_pool_t *pool = &list_cache_pool[index];
+        pthread_mutex_lock(&pool->mutex);
+        if (NULL != pool->batches) {
+            cache->nodes  = pool->batches;
+            cache->count  = LIST_CACHE_BATCH;
+            pool->batches = pool->batches->batch;
+            pool->count--;
+        }
+        pthread_mutex_unlock(&pool->mutex);
+
+        /* Register the flush of the caches when the thread exits */
+        if ((NULL != cache->nodes) && (NULL == pthread_getspecific(list_cache_key))) {
+            pthread_setspecific(list_cache_key, list_cache);
+        }
     }
 
-    /* Get element */
-    if (NULL != list->curr) {
-        e = list->curr->e;
+    /* Allocate memory if there is no free list element */
+    if (NULL == cache->nodes) {
+        return malloc(size);
     }
 
-    /* Release semaphore */
-    sem_post(&list->sem);
+    /* Get a free list element */
+    list_cache_node_t *node = cache->nodes;
+    cache->nodes            = node->next;
+    cache->count--;
 
-    return e;
+    return node;
 }
 
 /**
- * @brief Get previous element of the list
- * @param list List instance
- * @return Previous element of the list, NULL if the beginning of the list is reached
+ * @brief Release a list element to the cache of the current thread, a batch of list elements is returned to the global pool when the cache is full
+ * @param size Size of the list element
+ * @param ptr List element to be released
  */
-void *
-list_get_prev(list_t *list) {
+static void
+list_cache_free(size_t size, void *ptr) {
 
-    assert(NULL != list);
+    size_t index = (size - LIST_ARENA_ALIGN(sizeof(list_element_t))) / (2 * sizeof(void *));
+    assert(LIST_CACHE_CLASSES > index);
+    assert(NULL != ptr);
 
-    void *e = NULL;
+    list_cache_t *cache = &list_cache[index];
+
+    /* Register the flush of the caches when the thread exits */
+    if ((NULL == cache->nodes) && (NULL == pthread_getspecific(list_cache_key))) {
+        pthread_setspecific(list_cache_key, list_cache);
+    }
 
-    /* Wait semaphore */
-    sem_wait(&list->sem);
+    /* Add the list element to the cache */
+    list_cache_node_t *node = (list_cache_node_t *)ptr;
+    node->next              = cache->nodes;
+    cache->nodes            = node;
+    cache->count++;
 
-    /* Get previous list element */
-    if (NULL != list->curr) {
-        list->curr = list->curr->prev;
+    /* Return a batch to the global pool if the cache is full, the batch is released if the pool is full */
+    if (2 * LIST_CACHE_BATCH <= cache->count) {
+        list_cache_node_t *batch = cache->nodes;
+        list_cache_node_t *last  = batch;
+        for (size_t count = 1; count < LIST_CACHE_BATCH; count++) {
+            last = last->next;
+        }
+        cache->nodes = last->next;
+        cache->count -= LIST_CACHE_BATCH;
+        last->next = NULL;
+
+        /* Add the batch to the global pool */
+        list_cache_pool_t *pool = &list_cache_pool[index];
+        pthread_mutex_lock(&pool->mutex);
+        if (LIST_CACHE_POOL > pool->count) {
+            batch->batch  = pool->batches;
+            pool->batches = batch;
+            pool->count++;
+            batch = NULL;
+        }
+        pthread_mutex_unlock(&pool->mutex);
+        while (NULL != batch) {
+            node  = batch;
+            batch = batch->next;
+            free(node);
+        }
     }
+}
 
-    /* Get element */
-    if (NULL != list->curr) {
-        e = list->curr->e;
+/**
+ * @brief Create the global pools and the key used to flush the per-thread caches when the thread exits
+ */
+static void
+list_cache_init(void) {
+
+    /* Initialize the global pools */
+    for (size_t index = 0; index < LIST_CACHE_CLASSES; index++) {
+        pthread_mutex_init(&list_cache_pool[index].mutex, NULL);
     }
 
-    /* Release semaphore */
-    sem_post(&list->sem);
+    /* Create the key */
+    pthread_key_create(&list_cache_key, list_cache_flush);
+}
 
-    return e;
+/**
+ * @brief Flush the per-thread caches when the thread exits
+ * @param arg Unused
+ */
+static void
+list_cache_flush(void *arg) {
+
+    (void)arg;
+
+    /* Release all the free list elements of the caches of the thread */
+    for (size_t index = 0; index < LIST_CACHE_CLASSES; index++) {
+        list_cache_t *cache = &list_cache[index];
+        while (NULL != cache->nodes) {
+            list_cache_node_t *node = cache->nodes;
+            cache->nodes            = node->next;
+            free(node);
+        }
+        cache->count = 0;
+    }
 }
 
 /**
- * @brief Remove element of the list
+ * @brief Allocate memory to copy an element, using the pools of the list if possible
  * @param list List instance
- * @return Next element of the list, NULL if the element was tail element of the list
+ * @param size Size of the element
+ * @return Allocated memory, NULL if an error occurred
  */
-void *
-list_remove(list_t *list, void *e) {
+static void *
+list_alloc_payload(list_t *list, size_t size) {
 
     assert(NULL != list);
 
-    void *ret = NULL;
-
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
-    /* Search for the list element in the list */
-    list_element_t *tmp = list->first;
-    while (NULL != tmp) {
-        if (tmp->e == e) {
-            break;
+    /* Allocate the shared copy of the element with its header */
+    if (true == list->shared) {
+        size_t         offset = LIST_ARENA_ALIGN(sizeof(list_shared_t));
+        list_shared_t *shared = (list_shared_t *)list_alloc_memory(list, offset + size);
+        if (NULL == shared) {
+            /* Unable to allocate memory */
+            return NULL;
         }
-        tmp = tmp->next;
-    }
-    if (NULL == tmp) {
-        /* The element is not part of the list */
-        sem_post(&list->sem);
-        return NULL;
+        shared->refs      = 1;
+        shared->size      = size;
+        shared->allocator = list->allocator;
+        return (unsigned char *)shared + offset;
     }
 
-    /* Update first element if required */
-    if (tmp == list->first) {
-        list->first = tmp->next;
+    /* Allocate memory if the element is not stored in a pool */
+    list_pool_t *pool = list_get_pool(list, size);
+    if (NULL == pool) {
+        return list_alloc_memory(list, size);
     }
 
-    /* Update last element if required */
-    if (tmp == list->last) {
-        list->last = tmp->prev;
+    /* Lock the pools */
+    if (LIST_LOCK_NONE != list->lock) {
+        pthread_mutex_lock(&list->pools->mutex);
     }
 
-    /* Update current element if required */
-    if (tmp == list->curr) {
-        list->curr = tmp->prev;
+    /* Add a block of slots to the pool if there is no free slot */
+    if (NULL == pool->slots) {
+        size_t        offset = LIST_ARENA_ALIGN(sizeof(list_block_t));
+        size_t        count  = (LIST_POOL_BLOCK_SIZE - offset > pool->size) ? (LIST_POOL_BLOCK_SIZE - offset) / pool->size : 1;
+        list_block_t *block  = (list_block_t *)list_alloc_memory(list, offset + count * pool->size);
+        if (NULL != block) {
+            block->size  = offset + count * pool->size;
+            block->next  = pool->blocks;
+            pool->blocks = block;
+            pool->held += block->size;
+            for (size_t index = count; 0 < index; index--) {
+                list_slot_t *slot = (list_slot_t *)((unsigned char *)block + offset + (index - 1) * pool->size);
+                slot->next        = pool->slots;
+                pool->slots       = slot;
+            }
+        }
     }
 
-    /* Update the list */
-    if (NULL != tmp->prev) {
-        tmp->prev->next = tmp->next;
+    /* Get a free slot */
+    list_slot_t *slot = pool->slots;
+    if (NULL != slot) {
+        pool->slots = slot->next;
+        pool->used++;
     }
-    if (NULL != tmp->next) {
-        tmp->next->prev = tmp->prev;
-    }
-    list->count--;
 
-    /* Set next element */
-    ret = tmp->next;
-
-    /* Release memory */
-    if ((true == list->alloc) && (NULL != tmp->e)) {
-        free(tmp->e);
+    /* Unlock the pools */
+    if (LIST_LOCK_NONE != list->lock) {
+        pthread_mutex_unlock(&list->pools->mutex);
     }
-    free(tmp);
-
-    /* Release semaphore */
-    sem_post(&list->sem);
 
-    return ret;
+    return slot;
 }
 
 /**
- * @brief Remove head element of the list
+ * @brief Release memory of the copy of an element, using the pools of the list if possible
  * @param list List instance
- * @return Head element of the list, NULL if the list is empty
+ * @param ptr Memory to be released
+ * @param size Size of the element
  */
-void *
-list_remove_head(list_t *list) {
+static void
+list_free_payload(list_t *list, void *ptr, size_t size) {
 
     assert(NULL != list);
+    assert(NULL != ptr);
 
-    void *e = NULL;
-
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
-    /* Update current element if required */
-    if ((NULL != list->curr) && (list->curr == list->first)) {
-        list->curr = list->first->next;
+    /* Release the shared copy of the element when the last reference is released, using the allocator of the list which has allocated it */
+    if (true == list->shared) {
+        list_shared_t *shared = list_get_shared(ptr);
+        if (0 == __atomic_sub_fetch(&shared->refs, 1, __ATOMIC_ACQ_REL)) {
+            if (NULL != shared->allocator.free) {
+                shared->allocator.free(shared, LIST_ARENA_ALIGN(sizeof(list_shared_t)) + shared->size, shared->allocator.ctx);
+            } else {
+                free(shared);
+            }
+        }
+        return;
     }
 
-    /* Get head element */
-    if (NULL != list->first) {
-        e = list->first->e;
+    /* Release memory if the element is not stored in a pool */
+    list_pool_t *pool = list_get_pool(list, size);
+    if (NULL == pool) {
+        list_free_memory(list, ptr, size);
+        return;
     }
 
-    /* Update the list */
-    if (NULL != list->first) {
-        list_element_t *tmp = list->first;
-        if (NULL != list->first->next) {
-            list->first->next->prev = NULL;
-            list->first             = list->first->next;
-        } else {
-            list->first = list->last = NULL;
-        }
-        list->count--;
-        free(tmp);
+    /* Lock the pools */
+    if (LIST_LOCK_NONE != list->lock) {
+        pthread_mutex_lock(&list->pools->mutex);
     }
 
-    /* Release semaphore */
-    sem_post(&list->sem);
+    /* Release the slot */
+    list_slot_t *slot = (list_slot_t *)ptr;
+    slot->next        = pool->slots;
+    pool->slots       = slot;
+    pool->used--;
 
-    return e;
+    /* Unlock the pools */
+    if (LIST_LOCK_NONE != list->lock) {
+        pthread_mutex_unlock(&list->pools->mutex);
+    }
 }
 
 /**
- * @brief Remove tail element of the list
+ * @brief Get the pool used to copy an element
  * @param list List instance
- * @return Tail element of the list, NULL if the list is empty
+ * @param size Size of the element
+ * @return Pool, NULL if the element is too large or if pools are not used
  */
-void *
-list_remove_tail(list_t *list) {
+static list_pool_t *
+list_get_pool(list_t *list, size_t size) {
 
     assert(NULL != list);
 
-    void *e = NULL;
-
-    /* Wait semaphore */
-    sem_wait(&list->sem);
-
-    /* Update current element if required */
-    if ((NULL != list->curr) && (list->curr == list->last)) {
-        list->curr = list->last->prev;
-    }
-
-    /* Get tail element */
-    if (NULL != list->last) {
-        e = list->last->e;
-    }
-
-    /* Update the list */
-    if (NULL != list->last) {
-        list_element_t *tmp = list->last;
-        if (NULL != list->last->prev) {
-            list->last->prev->next = NULL;
-            list->last             = list->last->prev;
-        } else {
-            list->first = list->last = NULL;
+    /* Search the smallest slots large enough */
+    if (NULL != list->pools) {
+        for (size_t index = 0; index < list->pools->count; index++) {
+            if (size <= list->pools->pool[index].size) {
+                return &list->pools->pool[index];
+            }
         }
-        list->count--;
-        free(tmp);
     }
 
-    /* Release semaphore */
-    sem_post(&list->sem);
-
-    return e;
+    return NULL;
 }
 
 /**
- * @brief Release list instance
- * @param list List instance
+ * @brief Get header of a shared copy of an element
+ * @param e Element
+ * @return Header of the shared copy
  */
-void
-list_release(list_t *list) {
+static list_shared_t *
+list_get_shared(void *e) {
 
-    /* Release list instance */
-    if (NULL != list) {
+    assert(NULL != e);
 
-        /* Wait semaphore */
-        sem_wait(&list->sem);
+    return (list_shared_t *)((unsigned char *)e - LIST_ARENA_ALIGN(sizeof(list_shared_t)));
+}
 
-        /* Release list elements */
-        list_element_t *list_element = list->first;
-        while (NULL != list_element) {
-            list_element_t *tmp = list_element;
-            list_element        = list_element->next;
-            if ((true == list->alloc) && (NULL != tmp->e)) {
-                free(tmp->e);
-            }
-            free(tmp);
-        }
+#ifdef LIST_HISTOGRAMS
+/**
+ * @brief Record a sample in a latency histogram
+ * @param histogram Latency histogram
+ * @param value Sample in nanoseconds
+ */
+static void
+list_histogram_record(list_histogram_t *histogram, uint64_t value) {
 
-        /* Release semaphore */
-        sem_post(&list->sem);
-        sem_close(&list->sem);
+    assert(NULL != histogram);
 
-        /* Release list instance */
-        free(list);
+    /* Values smaller than the number of sub-buckets are recorded exactly, others keep the most significant bits */
+    size_t index = (size_t)value;
+    if ((1 << LIST_HISTOGRAM_SUB_BITS) <= value) {
+        size_t magnitude = 63 - __builtin_clzll(value);
+        index            = ((magnitude - LIST_HISTOGRAM_SUB_BITS + 1) << LIST_HISTOGRAM_SUB_BITS)
+                + ((value >> (magnitude - LIST_HISTOGRAM_SUB_BITS)) & ((1 << LIST_HISTOGRAM_SUB_BITS) - 1));
+    }
+    if (LIST_HISTOGRAM_BUCKETS <= index) {
+        index = LIST_HISTOGRAM_BUCKETS - 1;
+    }
+
+    /* Update histogram */
+    __atomic_fetch_add(&histogram->buckets[index], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->count, 1, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+    while ((max < value) && (false == __atomic_compare_exchange_n(&histogram->max, &max, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+        /* Retry with the maximum value updated by another thread */
     }
 }
 
 /**
- * @brief Create a list element
- * @param list List instance
- * @param e Element to be added in the list
- * @param size Size of the element to be added
- * @return 0 if the function succeeded, -1 otherwise
+ * @brief Compute latency percentiles of a histogram
+ * @param histogram Latency histogram
+ * @param latency Latency percentiles
  */
-static list_element_t *
-list_create_element(list_t *list, void *e, size_t size) {
+static void
+list_histogram_percentiles(list_histogram_t *histogram, list_latency_t *latency) {
 
-    assert(NULL != list);
-    assert(NULL != e);
+    assert(NULL != histogram);
+    assert(NULL != latency);
 
-    /* Create a new list element */
-    list_element_t *list_element = (list_element_t *)malloc(sizeof(list_element_t));
-    if (NULL == list_element) {
-        /* Unable to allocate memory */
-        return NULL;
+    static const uint64_t permille[] = { 500, 900, 990, 999 };
+    uint64_t *            values[]   = { &latency->p50, &latency->p90, &latency->p99, &latency->p999 };
+
+    /* Copy the buckets, the histogram may be updated concurrently */
+    uint64_t buckets[LIST_HISTOGRAM_BUCKETS];
+    uint64_t count = 0;
+    for (size_t index = 0; index < LIST_HISTOGRAM_BUCKETS; index++) {
+        buckets[index] = __atomic_load_n(&histogram->buckets[index], __ATOMIC_RELAXED);
+        count += buckets[index];
     }
-    memset(list_element, 0, sizeof(list_element_t));
+    latency->count = count;
+    latency->max   = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
 
-    /* Store element */
-    if (true == list->alloc) {
-        if (NULL == (list_element->e = malloc(size))) {
-            /* Unable to allocate memory */
-            free(list_element);
-            return NULL;
+    /* Search the buckets of the percentiles, percentiles are reported as the highest value of their bucket */
+    uint64_t sum   = 0;
+    size_t   index = 0;
+    for (size_t p = 0; p < sizeof(permille) / sizeof(uint64_t); p++) {
+        uint64_t rank = (count * permille[p] + 999) / 1000;
+        while ((index < LIST_HISTOGRAM_BUCKETS - 1) && (sum + buckets[index] < rank)) {
+            sum += buckets[index];
+            index++;
+        }
+        *values[p] = (0 != count) ? list_histogram_value(index) : 0;
+        if (latency->max < *values[p]) {
+            *values[p] = latency->max;
         }
-        memcpy(list_element->e, e, size);
-    } else {
-        list_element->e = e;
     }
+}
 
-    return list_element;
+/**
+ * @brief Get the highest value of a bucket of a latency histogram
+ * @param index Index of the bucket
+ * @return Highest value of the bucket in nanoseconds
+ */
+static uint64_t
+list_histogram_value(size_t index) {
+
+    /* Buckets of the first magnitude contain a single value */
+    if (index < (1 << LIST_HISTOGRAM_SUB_BITS)) {
+        return index;
+    }
+
+    size_t   shift = (index >> LIST_HISTOGRAM_SUB_BITS) - 1;
+    uint64_t base  = (1 << LIST_HISTOGRAM_SUB_BITS) + (index & ((1 << LIST_HISTOGRAM_SUB_BITS) - 1));
+
+    return ((base + 1) << shift) - 1;
 }
+#endif
@@ -0,0 +1,650 @@
+/**
+ * @file      list_lru.c
+ * @brief     LRU cache library
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "list_lru.h"
+
+/******************************************************************************/
+/* Definitions                                                                */
+/******************************************************************************/
+
+/**
+ * Initial number of hash buckets
+ */
+#define LIST_LRU_INITIAL_BUCKETS (64)
+
+/**
+ * Round a size up to the alignment of any type, so that values stored after the keys are aligned
+ */
+#define LIST_LRU_ALIGN(size) (((size) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+/**
+ * Size of an entry, key and value are stored just after the entry
+ */
+#define LIST_LRU_ENTRY_SIZE(key_size, value_size) (LIST_LRU_ALIGN(sizeof(list_lru_entry_t)) + LIST_LRU_ALIGN(key_size) + (value_size))
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Compute hash of a key
+ * @param key Key
+ * @param key_size Size of the key
+ * @return Hash of the key
+ */
+static uint64_t list_lru_hash(void *key, size_t key_size);
+
+/**
+ * @brief Search an entry of the cache, the cache must be locked
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @param hash Hash of the key
+ * @return Entry if the function succeeded, NULL if the entry is not in the cache
+ */
+static list_lru_entry_t *list_lru_find_entry(list_lru_t *lru, void *key, size_t key_size, uint64_t hash);
+
+/**
+ * @brief Remove an entry from the hash buckets and from the recency list, the cache must be locked
+ * @param lru LRU cache instance
+ * @param entry Entry
+ */
+static void list_lru_unlink_entry(list_lru_t *lru, list_lru_entry_t *entry);
+
+/**
+ * @brief Invoke the eviction callback for evicted entries and release them, the cache must not be locked
+ * @param lru LRU cache instance
+ * @param evicted Evicted entries, chained using the next field of the entries
+ * @param fct Eviction callback function, NULL if not used
+ * @param user User data passed to the callback function
+ */
+static void list_lru_release_evicted(list_lru_t *lru, list_lru_entry_t *evicted, void (*fct)(list_lru_t *, void *, size_t, void *, size_t, void *), void *user);
+
+/**
+ * @brief Double the number of hash buckets, the cache must be locked
+ * @param lru LRU cache instance
+ */
+static void list_lru_grow(list_lru_t *lru);
+
+/**
+ * @brief Allocate an entry using the allocator of the recency list
+ * @param lru LRU cache instance
+ * @param key_size Size of the key
+ * @param value_size Size of the value
+ * @return Entry if the function succeeded, NULL otherwise
+ */
+static list_lru_entry_t *list_lru_alloc_entry(list_lru_t *lru, size_t key_size, size_t value_size);
+
+/**
+ * @brief Release an entry using the allocator of the recency list
+ * @param lru LRU cache instance
+ * @param entry Entry
+ */
+static void list_lru_free_entry(list_lru_t *lru, list_lru_entry_t *entry);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Function used to create LRU cache instance
+ * @param max_count Maximum number of entries in the cache, 0 if not limited
+ * @param max_bytes Maximum size of the keys and values of the entries in the cache, 0 if not limited
+ * @return LRU cache instance if the function succeeded, NULL otherwise
+ */
+list_lru_t *
+list_lru_create(size_t max_count, size_t max_bytes) {
+
+    /* Create LRU cache instance using malloc */
+    return list_lru_create_allocator(max_count, max_bytes, NULL);
+}
+
+/**
+ * @brief Function used to create LRU cache instance with a custom allocator
+ * @param max_count Maximum number of entries in the cache, 0 if not limited
+ * @param max_bytes Maximum size of the keys and values of the entries in the cache, 0 if not limited
+ * @param allocator Allocator of the entries and of the elements of the recency list, NULL to use malloc
+ * @return LRU cache instance if the function succeeded, NULL otherwise
+ */
+list_lru_t *
+list_lru_create_allocator(size_t max_count, size_t max_bytes, const list_allocator_t *allocator) {
+
+    /* Create LRU cache instance */
+    list_lru_t *lru = (list_lru_t *)malloc(sizeof(list_lru_t));
+    if (NULL == lru) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+    memset(lru, 0, sizeof(list_lru_t));
+
+    /* Create recency list, the access is protected by the semaphore of the cache */
+    list_options_t options = { .mode = LIST_MODE_LINKED, .lock = LIST_LOCK_NONE };
+    if (NULL == (lru->list = list_create_allocator(false, NULL, &options, allocator))) {
+        /* Unable to create recency list */
+        free(lru);
+        return NULL;
+    }
+
+    /* Create hash buckets */
+    if (NULL == (lru->buckets = (list_lru_entry_t **)calloc(LIST_LRU_INITIAL_BUCKETS, sizeof(list_lru_entry_t *)))) {
+        /* Unable to allocate memory */
+        list_release(lru->list);
+        free(lru);
+        return NULL;
+    }
+    lru->nbuckets = LIST_LRU_INITIAL_BUCKETS;
+
+    /* Save limits */
+    lru->max_count = max_count;
+    lru->max_bytes = max_bytes;
+
+    /* Initialize semaphore used to access the cache */
+    sem_init(&lru->sem, 0, 1);
+
+    return lru;
+}
+
+/**
+ * @brief Register callback function invoked when an entry is evicted from the cache, after the entry has been removed and without holding the lock of the cache
+ * @param lru LRU cache instance
+ * @param fct Callback function, invoked with the cache, the key, the key size, the value, the value size and the user data
+ * @param user User data passed to the callback function
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_lru_on_evict(list_lru_t *lru, void (*fct)(list_lru_t *, void *, size_t, void *, size_t, void *), void *user) {
+
+    assert(NULL != lru);
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Save callback */
+    lru->cb.fct  = fct;
+    lru->cb.user = user;
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    return 0;
+}
+
+/**
+ * @brief Add or replace an entry of the cache, the entry becomes the most recently used
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @param value Value of the entry
+ * @param value_size Size of the value
+ * @return 0 if the function succeeded, -1 otherwise
+ */
+int
+list_lru_put(list_lru_t *lru, void *key, size_t key_size, void *value, size_t value_size) {
+
+    assert(NULL != lru);
+    assert(NULL != key);
+    assert((NULL != value) || (0 == value_size));
+
+    /* Create a new entry, key and value are stored just after the entry, the value is aligned */
+    list_lru_entry_t *entry = list_lru_alloc_entry(lru, key_size, value_size);
+    if (NULL == entry) {
+        /* Unable to allocate memory */
+        return -1;
+    }
+    memset(entry, 0, sizeof(list_lru_entry_t));
+    entry->hash       = list_lru_hash(key, key_size);
+    entry->key        = (uint8_t *)entry + LIST_LRU_ALIGN(sizeof(list_lru_entry_t));
+    entry->key_size   = key_size;
+    entry->value      = (uint8_t *)entry->key + LIST_LRU_ALIGN(key_size);
+    entry->value_size = value_size;
+    memcpy(entry->key, key, key_size);
+    if (0 < value_size) {
+        memcpy(entry->value, value, value_size);
+    }
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Search previous entry with the same key */
+    list_lru_entry_t *tmp = list_lru_find_entry(lru, key, key_size, entry->hash);
+
+    /* Add the entry at the tail of the recency list, the previous entry is kept if the entry can't be added */
+    if (NULL == (entry->handle = list_add_handle(lru->list, entry, 0))) {
+        /* Unable to add the entry */
+        sem_post(&lru->sem);
+        list_lru_free_entry(lru, entry);
+        return -1;
+    }
+
+    /* Remove previous entry with the same key */
+    if (NULL != tmp) {
+        list_lru_unlink_entry(lru, tmp);
+        list_lru_free_entry(lru, tmp);
+    }
+
+    /* Add the entry to the hash buckets */
+    size_t index        = entry->hash % lru->nbuckets;
+    entry->next         = lru->buckets[index];
+    lru->buckets[index] = entry;
+    lru->count++;
+    lru->bytes += key_size + value_size;
+    if (lru->count > lru->nbuckets) {
+        list_lru_grow(lru);
+    }
+
+    /* Evict least recently used entries while the limits are exceeded, the new entry is always kept */
+    list_lru_entry_t *evicted = NULL;
+    while ((1 < lru->count) && (((0 < lru->max_count) && (lru->count > lru->max_count)) || ((0 < lru->max_bytes) && (lru->bytes > lru->max_bytes)))) {
+        tmp = (list_lru_entry_t *)list_get_head(lru->list);
+        list_lru_unlink_entry(lru, tmp);
+        tmp->next = evicted;
+        evicted   = tmp;
+    }
+    void (*fct)(list_lru_t *, void *, size_t, void *, size_t, void *) = lru->cb.fct;
+    void *user                                                        = lru->cb.user;
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    /* Release evicted entries, the callback may call the functions of the cache */
+    list_lru_release_evicted(lru, evicted, fct, user);
+
+    return 0;
+}
+
+/**
+ * @brief Get a copy of the value of an entry of the cache, the entry becomes the most recently used
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @param value Buffer where the value is copied, the value is truncated if it is larger than the buffer
+ * @param value_size Size of the buffer, set to the size of the value if the entry is in the cache
+ * @return 0 if the function succeeded, -1 if the entry is not in the cache
+ */
+int
+list_lru_get(list_lru_t *lru, void *key, size_t key_size, void *value, size_t *value_size) {
+
+    assert(NULL != lru);
+    assert(NULL != key);
+    assert(NULL != value_size);
+    assert((NULL != value) || (0 == *value_size));
+
+    int ret = -1;
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Search the entry, copy the value while the cache is locked because the entry may be released once unlocked, and move it to the tail of the recency list */
+    list_lru_entry_t *entry = list_lru_find_entry(lru, key, key_size, list_lru_hash(key, key_size));
+    if (NULL != entry) {
+        list_move_tail(lru->list, entry->handle);
+        if (0 < *value_size) {
+            memcpy(value, entry->value, (entry->value_size < *value_size) ? entry->value_size : *value_size);
+        }
+        *value_size = entry->value_size;
+        ret         = 0;
+    }
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    return ret;
+}
+
+/**
+ * @brief Mark an entry of the cache as the most recently used
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @return 0 if the function succeeded, -1 if the entry is not in the cache
+ */
+int
+list_lru_touch(list_lru_t *lru, void *key, size_t key_size) {
+
+    assert(NULL != lru);
+    assert(NULL != key);
+
+    int ret = -1;
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Search the entry and move it to the tail of the recency list */
+    list_lru_entry_t *entry = list_lru_find_entry(lru, key, key_size, list_lru_hash(key, key_size));
+    if (NULL != entry) {
+        ret = list_move_tail(lru->list, entry->handle);
+    }
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    return ret;
+}
+
+/**
+ * @brief Remove an entry of the cache, the eviction callback is not invoked
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @return 0 if the function succeeded, -1 if the entry is not in the cache
+ */
+int
+list_lru_remove(list_lru_t *lru, void *key, size_t key_size) {
+
+    assert(NULL != lru);
+    assert(NULL != key);
+
+    int ret = -1;
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Search the entry and release it */
+    list_lru_entry_t *entry = list_lru_find_entry(lru, key, key_size, list_lru_hash(key, key_size));
+    if (NULL != entry) {
+        list_lru_unlink_entry(lru, entry);
+        list_lru_free_entry(lru, entry);
+        ret = 0;
+    }
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    return ret;
+}
+
+/**
+ * @brief Evict the least recently used entry of the cache
+ * @param lru LRU cache instance
+ * @return 0 if the function succeeded, -1 if the cache is empty
+ */
+int
+list_lru_evict(list_lru_t *lru) {
+
+    assert(NULL != lru);
+
+    int ret = -1;
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Evict the entry at the head of the recency list */
+    list_lru_entry_t *entry = (list_lru_entry_t *)list_get_head(lru->list);
+    if (NULL != entry) {
+        list_lru_unlink_entry(lru, entry);
+        entry->next = NULL;
+        ret         = 0;
+    }
+    void (*fct)(list_lru_t *, void *, size_t, void *, size_t, void *) = lru->cb.fct;
+    void *user                                                        = lru->cb.user;
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    /* Release evicted entry, the callback may call the functions of the cache */
+    list_lru_release_evicted(lru, entry, fct, user);
+
+    return ret;
+}
+
+/**
+ * @brief Get number of entries in the cache
+ * @param lru LRU cache instance
+ * @return Number of entries in the cache
+ */
+size_t
+list_lru_get_count(list_lru_t *lru) {
+
+    assert(NULL != lru);
+
+    size_t count = 0;
+
+    /* Wait semaphore */
+    sem_wait(&lru->sem);
+
+    /* Get number of entries */
+    count = lru->count;
+
+    /* Release semaphore */
+    sem_post(&lru->sem);
+
+    return count;
+}
+
+/**
+ * @brief Release LRU cache instance, the eviction callback is not invoked
+ * @param lru LRU cache instance
+ */
+void
+list_lru_release(list_lru_t *lru) {
+
+    /* Release LRU cache instance */
+    if (NULL != lru) {
+
+        /* Wait semaphore */
+        sem_wait(&lru->sem);
+
+        /* Release entries */
+        list_lru_entry_t *entry = (list_lru_entry_t *)list_remove_head(lru->list);
+        while (NULL != entry) {
+            list_lru_free_entry(lru, entry);
+            entry = (list_lru_entry_t *)list_remove_head(lru->list);
+        }
+
+        /* Release recency list and hash buckets */
+        list_release(lru->list);
+        free(lru->buckets);
+
+        /* Release semaphore */
+        sem_post(&lru->sem);
+        sem_close(&lru->sem);
+
+        /* Release LRU cache instance */
+        free(lru);
+    }
+}
+
+/**
+ * @brief Compute hash of a key
+ * @param key Key
+ * @param key_size Size of the key
+ * @return Hash of the key
+ */
+static uint64_t
+list_lru_hash(void *key, size_t key_size) {
+
+    assert(NULL != key);
+
+    /* FNV-1a hash */
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t index = 0; index < key_size; index++) {
+        hash ^= ((uint8_t *)key)[index];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Search an entry of the cache, the cache must be locked
+ * @param lru LRU cache instance
+ * @param key Key of the entry
+ * @param key_size Size of the key
+ * @param hash Hash of the key
+ * @return Entry if the function succeeded, NULL if the entry is not in the cache
+ */
+static list_lru_entry_t *
+list_lru_find_entry(list_lru_t *lru, void *key, size_t key_size, uint64_t hash) {
+
+    assert(NULL != lru);
+    assert(NULL != key);
+
+    /* Parse entries of the hash bucket */
+    list_lru_entry_t *entry = lru->buckets[hash % lru->nbuckets];
+    while (NULL != entry) {
+        if ((hash == entry->hash) && (key_size == entry->key_size) && (0 == memcmp(key, entry->key, key_size))) {
+            return entry;
+        }
+        entry = entry->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remove an entry from the hash buckets and from the recency list, the cache must be locked
+ * @param lru LRU cache instance
+ * @param entry Entry
+ */
+static void
+list_lru_unlink_entry(list_lru_t *lru, list_lru_entry_t *entry) {
+
+    assert(NULL != lru);
+    assert(NULL != entry);
+
+    /* Remove the entry from the hash bucket */
+    list_lru_entry_t **tmp = &lru->buckets[entry->hash % lru->nbuckets];
+    while (entry != *tmp) {
+        tmp = &(*tmp)->next;
+    }
+    *tmp = entry->next;
+
+    /* Remove the entry from the recency list */
+    list_remove_handle(lru->list, entry->handle);
+    lru->count--;
+    lru->bytes -= entry->key_size + entry->value_size;
+}
+
+/**
+ * @brief Invoke the eviction callback for evicted entries and release them, the cache must not be locked
+ * @param lru LRU cache instance
+ * @param evicted Evicted entries, chained using the next field of the entries
+ * @param fct Eviction callback function, NULL if not used
+ * @param user User data passed to the callback function
+ */
+static void
+list_lru_release_evicted(list_lru_t *lru, list_lru_entry_t *evicted, void (*fct)(list_lru_t *, void *, size_t, void *, size_t, void *), void *user) {
+
+    assert(NULL != lru);
+
+    /* Parse evicted entries */
+    while (NULL != evicted) {
+        list_lru_entry_t *next = evicted->next;
+
+        /* Invoke eviction callback */
+        if (NULL != fct) {
+            fct(lru, evicted->key, evicted->key_size, evicted->value, evicted->value_size, user);
+        }
+
+        /* Release memory */
+        list_lru_free_entry(lru, evicted);
+        evicted = next;
+    }
+}
+
+/**
+ * @brief Double the number of hash buckets, the cache must be locked
+ * @param lru LRU cache instance
+ */
+static void
+list_lru_grow(list_lru_t *lru) {
+
+    assert(NULL != lru);
+
+    /* Create new hash buckets, the current buckets are kept if memory is not available */
+    size_t             nbuckets = 2 * lru->nbuckets;
+    list_lru_entry_t **buckets  = (list_lru_entry_t **)calloc(nbuckets, sizeof(list_lru_entry_t *));
+    if (NULL == buckets) {
+        /* Unable to allocate memory */
+        return;
+    }
+
+    /* Move entries to the new hash buckets */
+    for (size_t index = 0; index < lru->nbuckets; index++) {
+        list_lru_entry_t *entry = lru->buckets[index];
+        while (NULL != entry) {
+            list_lru_entry_t *next = entry->next;
+            size_t            slot = entry->hash % nbuckets;
+            entry->next            = buckets[slot];
+            buckets[slot]          = entry;
+            entry                  = next;
+        }
+    }
+    free(lru->buckets);
+    lru->buckets  = buckets;
+    lru->nbuckets = nbuckets;
+}
+
+/**
+ * @brief Allocate an entry using the allocator of the recency list
+ * @param lru LRU cache instance
+ * @param key_size Size of the key
+ * @param value_size Size of the value
+ * @return Entry if the function succeeded, NULL otherwise
+ */
+static list_lru_entry_t *
+list_lru_alloc_entry(list_lru_t *lru, size_t key_size, size_t value_size) {
+
+    assert(NULL != lru);
+
+    /* Use the allocator of the recency list if defined */
+    if (NULL != lru->list->allocator.alloc) {
+        return (list_lru_entry_t *)lru->list->allocator.alloc(LIST_LRU_ENTRY_SIZE(key_size, value_size), lru->list->allocator.ctx);
+    }
+
+    return (list_lru_entry_t *)malloc(LIST_LRU_ENTRY_SIZE(key_size, value_size));
+}
+
+/**
+ * @brief Release an entry using the allocator of the recency list
+ * @param lru LRU cache instance
+ * @param entry Entry
+ */
+static void
+list_lru_free_entry(list_lru_t *lru, list_lru_entry_t *entry) {
+
+    assert(NULL != lru);
+    assert(NULL != entry);
+
+    /* Use the allocator of the recency list if defined */
+    if (NULL != lru->list->allocator.free) {
+        lru->list->allocator.free(entry, LIST_LRU_ENTRY_SIZE(entry->key_size, entry->value_size), lru->list->allocator.ctx);
+    } else {
+        free(entry);
+    }
+}
@@ -0,0 +1,465 @@
+/**
+ * @file      list_wheel.c
+ * @brief     Timer wheel library
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021-2023 joelguittet and c-list contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/******************************************************************************/
+/* Includes                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "list_wheel.h"
+
+/******************************************************************************/
+/* Prototypes                                                                 */
+/******************************************************************************/
+
+/**
+ * @brief Initialize an empty circular chain
+ * @param chain Head of the chain
+ */
+static void list_wheel_init_chain(list_element_t *chain);
+
+/**
+ * @brief Append an element at the end of a circular chain
+ * @param chain Head of the chain
+ * @param element Element to be appended
+ */
+static void list_wheel_append(list_element_t *chain, list_element_t *element);
+
+/**
+ * @brief Unlink an element from its circular chain
+ * @param element Element to be unlinked
+ */
+static void list_wheel_unlink(list_element_t *element);
+
+/**
+ * @brief Link a timer in the slot corresponding to its expiry, the wheel must be locked
+ * @param wheel Timer wheel instance
+ * @param timer Timer
+ */
+static void list_wheel_link(list_wheel_t *wheel, list_wheel_timer_t *timer);
+
+/**
+ * @brief Move the timers of the current slot of a level to the lower levels, the wheel must be locked
+ * @param wheel Timer wheel instance
+ * @param level Level of the wheel
+ */
+static void list_wheel_cascade(list_wheel_t *wheel, size_t level);
+
+/**
+ * @brief Move all the timers of a chain at the end of the expired chain, the wheel must be locked
+ * @param wheel Timer wheel instance
+ * @param chain Head of the chain
+ * @param expired Head of the expired chain
+ */
+static void list_wheel_expire(list_wheel_t *wheel, list_element_t *chain, list_element_t *expired);
+
+/******************************************************************************/
+/* Functions                                                                  */
+/******************************************************************************/
+
+/**
+ * @brief Function used to create timer wheel instance
+ * @param now Current tick
+ * @return Timer wheel instance if the function succeeded, NULL otherwise
+ */
+list_wheel_t *
+list_wheel_create(uint64_t now) {
+
+    /* Create timer wheel instance */
+    list_wheel_t *wheel = (list_wheel_t *)malloc(sizeof(list_wheel_t));
+    if (NULL == wheel) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+    memset(wheel, 0, sizeof(list_wheel_t));
+
+    /* Initialize slots */
+    for (size_t level = 0; level < LIST_WHEEL_LEVELS; level++) {
+        for (size_t slot = 0; slot < LIST_WHEEL_SLOTS; slot++) {
+            list_wheel_init_chain(&wheel->slots[level][slot]);
+        }
+    }
+    list_wheel_init_chain(&wheel->due);
+
+    /* Save current tick */
+    wheel->now = now;
+
+    /* Initialize semaphore used to access the wheel */
+    sem_init(&wheel->sem, 0, 1);
+
+    return wheel;
+}
+
+/**
+ * @brief Schedule a timer in the wheel
+ * @param wheel Timer wheel instance
+ * @param expiry Expiry tick of the timer
+ * @param e User data of the timer
+ * @return Timer if the function succeeded, NULL otherwise
+ */
+list_wheel_timer_t *
+list_wheel_schedule(list_wheel_t *wheel, uint64_t expiry, void *e) {
+
+    assert(NULL != wheel);
+
+    /* Create a new timer */
+    list_wheel_timer_t *timer = (list_wheel_timer_t *)malloc(sizeof(list_wheel_timer_t));
+    if (NULL == timer) {
+        /* Unable to allocate memory */
+        return NULL;
+    }
+    memset(timer, 0, sizeof(list_wheel_timer_t));
+    timer->element.e = e;
+    timer->expiry    = expiry;
+
+    /* Wait semaphore */
+    sem_wait(&wheel->sem);
+
+    /* Add the timer to the wheel */
+    list_wheel_link(wheel, timer);
+    wheel->count++;
+
+    /* Release semaphore */
+    sem_post(&wheel->sem);
+
+    return timer;
+}
+
+/**
+ * @brief Cancel a timer of the wheel, the timer must not have expired
+ * @param wheel Timer wheel instance
+ * @param timer Timer
+ * @return User data of the timer
+ */
+void *
+list_wheel_cancel(list_wheel_t *wheel, list_wheel_timer_t *timer) {
+
+    assert(NULL != wheel);
+    assert(NULL != timer);
+
+    void *e = timer->element.e;
+
+    /* Wait semaphore */
+    sem_wait(&wheel->sem);
+
+    /* Remove the timer from its slot */
+    list_wheel_unlink(&timer->element);
+    if (timer->level < LIST_WHEEL_LEVELS) {
+        wheel->pending[timer->level]--;
+    }
+    wheel->count--;
+
+    /* Release semaphore */
+    sem_post(&wheel->sem);
+
+    /* Release memory */
+    free(timer);
+
+    return e;
+}
+
+/**
+ * @brief Advance the wheel to the current tick and expire the due timers
+ * @param wheel Timer wheel instance
+ * @param now Current tick
+ * @param fct Callback function invoked with the wheel, the user data of the timer and the user data for each expired timer
+ * @param user User data passed to the callback function
+ * @return Number of expired timers
+ */
+size_t
+list_wheel_advance(list_wheel_t *wheel, uint64_t now, void (*fct)(list_wheel_t *, void *, void *), void *user) {
+
+    assert(NULL != wheel);
+
+    size_t         count = 0;
+    list_element_t expired;
+
+    /* Initialize the chain of the expired timers */
+    list_wheel_init_chain(&expired);
+
+    /* Wait semaphore */
+    sem_wait(&wheel->sem);
+
+    /* Expire the timers already due when they have been scheduled */
+    list_wheel_expire(wheel, &wheel->due, &expired);
+
+    /* Advance the wheel tick by tick */
+    while (wheel->now < now) {
+
+        /* Directly jump to the current tick if there is no more timer in the wheel */
+        if (0 == wheel->count) {
+            wheel->now = now;
+            break;
+        }
+
+        /* Skip the ticks until the next cascade of the lowest level containing timers */
+        size_t lowest = 0;
+        while ((lowest < LIST_WHEEL_LEVELS - 1) && (0 == wheel->pending[lowest])) {
+            lowest++;
+        }
+        if (0 < lowest) {
+            uint64_t tick = wheel->now | (((uint64_t)1 << (LIST_WHEEL_BITS * lowest)) - 1);
+            if (tick >= now) {
+                wheel->now = now;
+                break;
+            }
+            wheel->now = tick;
+        }
+        wheel->now++;
+
+        /* Cascade the timers of the upper levels each time a lower level wraps */
+        for (size_t level = 1; level < LIST_WHEEL_LEVELS; level++) {
+            if (0 != ((wheel->now >> (LIST_WHEEL_BITS * (level - 1))) & (LIST_WHEEL_SLOTS - 1))) {
+                break;
+            }
+            list_wheel_cascade(wheel, level);
+        }
+
+        /* Expire the timers of the current slot and the cascaded timers which are due */
+        list_wheel_expire(wheel, &wheel->slots[0][wheel->now & (LIST_WHEEL_SLOTS - 1)], &expired);
+        list_wheel_expire(wheel, &wheel->due, &expired);
+    }
+
+    /* Release semaphore */
+    sem_post(&wheel->sem);
+
+    /* Invoke the callback for each expired timer, the wheel can be modified from the callback */
+    list_element_t *element = expired.next;
+    while (&expired != element) {
+        list_wheel_timer_t *timer = (list_wheel_timer_t *)element;
+        void *              e     = element->e;
+        element                   = element->next;
+        free(timer);
+        if (NULL != fct) {
+            fct(wheel, e, user);
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get number of timers in the wheel
+ * @param wheel Timer wheel instance
+ * @return Number of timers in the wheel
+ */
+size_t
+list_wheel_get_count(list_wheel_t *wheel) {
+
+    assert(NULL != wheel);
+
+    size_t count = 0;
+
+    /* Wait semaphore */
+    sem_wait(&wheel->sem);
+
+    /* Get number of timers */
+    count = wheel->count;
+
+    /* Release semaphore */
+    sem_post(&wheel->sem);
+
+    return count;
+}
+
+/**
+ * @brief Release timer wheel instance, the timers are cancelled
+ * @param wheel Timer wheel instance
+ */
+void
+list_wheel_release(list_wheel_t *wheel) {
+
+    /* Release timer wheel instance */
+    if (NULL != wheel) {
+
+        /* Wait semaphore */
+        sem_wait(&wheel->sem);
+
+        /* Release timers */
+        list_element_t expired;
+        list_wheel_init_chain(&expired);
+        list_wheel_expire(wheel, &wheel->due, &expired);
+        for (size_t level = 0; level < LIST_WHEEL_LEVELS; level++) {
+            for (size_t slot = 0; slot < LIST_WHEEL_SLOTS; slot++) {
+                list_wheel_expire(wheel, &wheel->slots[level][slot], &expired);
+            }
+        }
+        list_element_t *element = expired.next;
+        while (&expired != element) {
+            list_element_t *tmp = element;
+            element             = element->next;
+            free(tmp);
+        }
+
+        /* Release semaphore */
+        sem_post(&wheel->sem);
+        sem_close(&wheel->sem);
+
+        /* Release timer wheel instance */
+        free(wheel);
+    }
+}
+
+/**
+ * @brief Initialize an empty circular chain
+ * @param chain Head of the chain
+ */
+static void
+list_wheel_init_chain(list_element_t *chain) {
+
+    assert(NULL != chain);
+
+    chain->prev = chain->next = chain;
+}
+
+/**
+ * @brief Append an element at the end of a circular chain
+ * @param chain Head of the chain
+ * @param element Element to be appended
+ */
+static void
+list_wheel_append(list_element_t *chain, list_element_t *element) {
+
+    assert(NULL != chain);
+    assert(NULL != element);
+
+    element->prev     = chain->prev;
+    element->next     = chain;
+    chain->prev->next = element;
+    chain->prev       = element;
+}
+
+/**
+ * @brief Unlink an element from its circular chain
+ * @param element Element to be unlinked
+ */
+static void
+list_wheel_unlink(list_element_t *element) {
+
+    assert(NULL != element);
+
+    element->prev->next = element->next;
+    element->next->prev = element->prev;
+    element->prev       = NULL;
+    element->next       = NULL;
+}
+
+/**
+ * @brief Link a timer in the slot corresponding to its expiry, the wheel must be locked
+ * @param wheel Timer wheel instance
+ * @param timer Timer
+ */
+static void
+list_wheel_link(list_wheel_t *wheel, list_wheel_timer_t *timer) {
+
+    assert(NULL != wheel);
+    assert(NULL != timer);
+
+    /* Timers already due are expired on the next advance of the wheel */
+    if (timer->expiry <= wheel->now) {
+        list_wheel_append(&wheel->due, &timer->element);
+        timer->level = LIST_WHEEL_LEVELS;
+        return;
+    }
+
+    /* Select the level of the wheel according to the delay of the timer */
+    uint64_t delay = timer->expiry - wheel->now;
+    size_t   level = 0;
+    while ((level < LIST_WHEEL_LEVELS - 1) && (delay >> (LIST_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    /* Timers beyond the range of the wheel are stored at the end of the last level and cascaded again later */
+    uint64_t expiry = timer->expiry;
+    if (0 != (delay >> (LIST_WHEEL_BITS * LIST_WHEEL_LEVELS))) {
+        expiry = wheel->now + ((uint64_t)1 << (LIST_WHEEL_BITS * LIST_WHEEL_LEVELS)) - 1;
+    }
+
+    /* Add the timer to the slot */
+    list_wheel_append(&wheel->slots[level][(expiry >> (LIST_WHEEL_BITS * level)) & (LIST_WHEEL_SLOTS - 1)], &timer->element);
+    timer->level = level;
+    wheel->pending[level]++;
+}
+
+/**
+ * @brief Move the timers of the current slot of a level to the lower levels, the wheel must be locked
+ * @param wheel Timer wheel instance
+ * @param level Level of the wheel
+ */
+static void
+list_wheel_cascade(list_wheel_t *wheel, size_t level) {
+
+    assert(NULL != wheel);
+    assert(0 < level);
+
+    /* Link again each timer of the slot according to its expiry */
+    list_element_t *chain   = &wheel->slots[level][(wheel->now >> (LIST_WHEEL_BITS * level)) & (LIST_WHEEL_SLOTS - 1)];
+    list_element_t *element = chain->next;
+    list_wheel_init_chain(chain);
+    while (chain != element) {
+        list_element_t *next = element->next;
+        wheel->pending[level]--;
+        list_wheel_link(wheel, (list_wheel_timer_t *)element);
+        element = next;
+    }
+}
+
+/**
+ * @brief Move all the timers of a chain at the end of the expired chain, the wheel must be locked
+ * @param wheel Timer wheel instance
+ * @param chain Head of the chain
+ * @param expired Head of the expired chain
+ */
+static void
+list_wheel_expire(list_wheel_t *wheel, list_element_t *chain, list_element_t *expired) {
+
+    assert(NULL != wheel);
+    assert(NULL != chain);
+    assert(NULL != expired);
+
+    /* Splice the chain at the end of the expired chain */
+    if (chain != chain->next) {
+        for (list_element_t *element = chain->next; chain != element; element = element->next) {
+            list_wheel_timer_t *timer = (list_wheel_timer_t *)element;
+            if (timer->level < LIST_WHEEL_LEVELS) {
+                wheel->pending[timer->level]--;
+            }
+            wheel->count--;
+        }
+        chain->next->prev   = expired->prev;
+        expired->prev->next = chain->next;
+        chain->prev->next   = expired;
+        expired->prev       = chain->prev;
+        list_wheel_init_chain(chain);
+    }
+}